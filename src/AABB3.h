@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+#include "Math.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Line3.h"
+#include "Plane3.h"
+
+template <typename T>
+struct AABB3
+{
+	Point3<T> min{ std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+	Point3<T> max{ -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity() };
+
+	AABB3() = default;
+	AABB3(const Point3<T>& min, const Point3<T>& max);
+	explicit AABB3(std::span<const Point3<T>> points);
+
+	Point3<T> Center() const;
+	Vector3<T> Extents() const;
+
+	bool IsEmpty() const;
+
+	void Expand(const Point3<T>& point);
+	void Expand(const AABB3& other);
+	AABB3 Union(const AABB3& other) const;
+
+	std::optional<std::pair<T, T>> ClipLine(const Line3<T>& line, const T tMin = 0, const T tMax = 1) const;
+
+	bool ContainsPoint(const Point3<T>& point) const;
+
+	bool IsInFrontOf(const Plane3<T>& plane) const;
+	bool IsBehind(const Plane3<T>& plane) const;
+
+	bool IsIntersectingWith(const Plane3<T>& plane) const;
+	bool IsIntersectingWith(const Line3<T>& line) const;
+	bool IsIntersectingWith(const AABB3& other) const;
+
+private:
+	std::pair<T, T> ProjectOnto(const Plane3<T>& plane) const;
+};
+
+using AABB3f = AABB3<float>;
+using AABB3d = AABB3<double>;
+using AABB3ld = AABB3<long double>;
+
+// Structure-of-arrays storage for many boxes, tested against a single primitive per call.
+template <typename T>
+struct AABB3Batch
+{
+	explicit AABB3Batch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	void Reserve(const size_t count);
+
+	void Add(const AABB3<T>& box);
+	void Clear();
+
+	size_t GetCount() const;
+	AABB3<T> Get(const size_t index) const;
+
+	void IsIntersectingWith(const Plane3<T>& plane, std::span<bool> results) const;
+	void IsIntersectingWith(const Line3<T>& line, std::span<bool> results) const;
+	void IsIntersectingWith(const AABB3<T>& box, std::span<bool> results) const;
+
+private:
+	std::pmr::vector<T> minX, minY, minZ;
+	std::pmr::vector<T> maxX, maxY, maxZ;
+};
+
+using AABB3Batchf = AABB3Batch<float>;
+using AABB3Batchd = AABB3Batch<double>;
+using AABB3Batchld = AABB3Batch<long double>;
+
+template <typename T>
+inline AABB3<T>::AABB3(const Point3<T>& min, const Point3<T>& max)
+	: min(min)
+	, max(max)
+{
+	Assert(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+}
+
+template <typename T>
+inline AABB3<T>::AABB3(std::span<const Point3<T>> points)
+{
+	for (const Point3<T>& point : points)
+		Expand(point);
+}
+
+template <typename T>
+inline Point3<T> AABB3<T>::Center() const
+{
+	return { (min.x + max.x) / 2, (min.y + max.y) / 2, (min.z + max.z) / 2 };
+}
+
+template <typename T>
+inline Vector3<T> AABB3<T>::Extents() const
+{
+	return (max - min) / static_cast<T>(2);
+}
+
+template <typename T>
+inline bool AABB3<T>::IsEmpty() const
+{
+	return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+template <typename T>
+inline void AABB3<T>::Expand(const Point3<T>& point)
+{
+	min = { std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z) };
+	max = { std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z) };
+}
+
+template <typename T>
+inline void AABB3<T>::Expand(const AABB3& other)
+{
+	min = { std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z) };
+	max = { std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z) };
+}
+
+template <typename T>
+inline AABB3<T> AABB3<T>::Union(const AABB3& other) const
+{
+	AABB3 retval(*this);
+	retval.Expand(other);
+	return retval;
+}
+
+template <typename T>
+inline std::optional<std::pair<T, T>> AABB3<T>::ClipLine(const Line3<T>& line, const T tMin, const T tMax) const
+{
+	const T points[] = { line.point.x, line.point.y, line.point.z };
+	const T directions[] = { line.direction.x, line.direction.y, line.direction.z };
+	const T mins[] = { min.x, min.y, min.z };
+	const T maxs[] = { max.x, max.y, max.z };
+
+	T tEnter = tMin;
+	T tExit = tMax;
+
+	// Only an exactly zero component is parallel: any slope, however small, crosses the slab somewhere along the line.
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (directions[i] == 0)
+		{
+			if (points[i] < mins[i] || points[i] > maxs[i]) return {};
+			continue;
+		}
+
+		T t1 = (mins[i] - points[i]) / directions[i];
+		T t2 = (maxs[i] - points[i]) / directions[i];
+		if (t1 > t2) std::swap(t1, t2);
+
+		tEnter = std::max(tEnter, t1);
+		tExit = std::min(tExit, t2);
+
+		if (tEnter > tExit) return {};
+	}
+
+	return { { tEnter, tExit } };
+}
+
+template <typename T>
+inline bool AABB3<T>::ContainsPoint(const Point3<T>& point) const
+{
+	return point.x >= min.x && point.x <= max.x
+		&& point.y >= min.y && point.y <= max.y
+		&& point.z >= min.z && point.z <= max.z;
+}
+
+template <typename T>
+inline bool AABB3<T>::IsInFrontOf(const Plane3<T>& plane) const
+{
+	const auto [distance, radius] = ProjectOnto(plane);
+	return distance > radius;
+}
+
+template <typename T>
+inline bool AABB3<T>::IsBehind(const Plane3<T>& plane) const
+{
+	const auto [distance, radius] = ProjectOnto(plane);
+	return distance < -radius;
+}
+
+template <typename T>
+inline bool AABB3<T>::IsIntersectingWith(const Plane3<T>& plane) const
+{
+	const auto [distance, radius] = ProjectOnto(plane);
+	return std::abs(distance) <= radius;
+}
+
+template <typename T>
+inline bool AABB3<T>::IsIntersectingWith(const Line3<T>& line) const
+{
+	return ClipLine(line, -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity()).has_value();
+}
+
+template <typename T>
+inline bool AABB3<T>::IsIntersectingWith(const AABB3& other) const
+{
+	return min.x <= other.max.x && max.x >= other.min.x
+		&& min.y <= other.max.y && max.y >= other.min.y
+		&& min.z <= other.max.z && max.z >= other.min.z;
+}
+
+template <typename T>
+inline std::pair<T, T> AABB3<T>::ProjectOnto(const Plane3<T>& plane) const
+{
+	const Vector3<T> extents = Extents();
+	const T radius = extents.x * std::abs(plane.normal.x) + extents.y * std::abs(plane.normal.y) + extents.z * std::abs(plane.normal.z);
+
+	return { plane.RelativeDistanceTo(Center()), radius };
+}
+
+template <typename T>
+inline AABB3Batch<T>::AABB3Batch(std::pmr::memory_resource* resource)
+	: minX(resource)
+	, minY(resource)
+	, minZ(resource)
+	, maxX(resource)
+	, maxY(resource)
+	, maxZ(resource)
+{
+}
+
+template <typename T>
+inline void AABB3Batch<T>::Reserve(const size_t count)
+{
+	minX.reserve(count);
+	minY.reserve(count);
+	minZ.reserve(count);
+	maxX.reserve(count);
+	maxY.reserve(count);
+	maxZ.reserve(count);
+}
+
+template <typename T>
+inline void AABB3Batch<T>::Add(const AABB3<T>& box)
+{
+	minX.push_back(box.min.x);
+	minY.push_back(box.min.y);
+	minZ.push_back(box.min.z);
+	maxX.push_back(box.max.x);
+	maxY.push_back(box.max.y);
+	maxZ.push_back(box.max.z);
+}
+
+template <typename T>
+inline void AABB3Batch<T>::Clear()
+{
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+template <typename T>
+inline size_t AABB3Batch<T>::GetCount() const
+{
+	return minX.size();
+}
+
+template <typename T>
+inline AABB3<T> AABB3Batch<T>::Get(const size_t index) const
+{
+	Assert(index < GetCount());
+	return { { minX[index], minY[index], minZ[index] }, { maxX[index], maxY[index], maxZ[index] } };
+}
+
+template <typename T>
+inline void AABB3Batch<T>::IsIntersectingWith(const Plane3<T>& plane, std::span<bool> results) const
+{
+	Assert(results.size() >= GetCount());
+
+	const T nx = plane.normal.x, ny = plane.normal.y, nz = plane.normal.z;
+	const T ax = std::abs(nx), ay = std::abs(ny), az = std::abs(nz);
+	const T d = -plane.normal.DotProduct(plane.point.ToVector());
+
+	const size_t count = GetCount();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const T cx = minX[i] + maxX[i], cy = minY[i] + maxY[i], cz = minZ[i] + maxZ[i];
+		const T ex = maxX[i] - minX[i], ey = maxY[i] - minY[i], ez = maxZ[i] - minZ[i];
+
+		const T distance = nx * cx + ny * cy + nz * cz + 2 * d;
+		const T radius = ax * ex + ay * ey + az * ez;
+		results[i] = std::abs(distance) <= radius;
+	}
+}
+
+template <typename T>
+inline void AABB3Batch<T>::IsIntersectingWith(const Line3<T>& line, std::span<bool> results) const
+{
+	Assert(results.size() >= GetCount());
+
+	// Axes the line runs exactly parallel to have infinite reciprocals; those slabs are handled by the containment mask.
+	const T px = line.point.x, py = line.point.y, pz = line.point.z;
+	const T ix = 1 / line.direction.x, iy = 1 / line.direction.y, iz = 1 / line.direction.z;
+	const bool parallelX = line.direction.x == 0, parallelY = line.direction.y == 0, parallelZ = line.direction.z == 0;
+
+	const size_t count = GetCount();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const T tx1 = parallelX ? -std::numeric_limits<T>::infinity() : (minX[i] - px) * ix;
+		const T tx2 = parallelX ? std::numeric_limits<T>::infinity() : (maxX[i] - px) * ix;
+		const T ty1 = parallelY ? -std::numeric_limits<T>::infinity() : (minY[i] - py) * iy;
+		const T ty2 = parallelY ? std::numeric_limits<T>::infinity() : (maxY[i] - py) * iy;
+		const T tz1 = parallelZ ? -std::numeric_limits<T>::infinity() : (minZ[i] - pz) * iz;
+		const T tz2 = parallelZ ? std::numeric_limits<T>::infinity() : (maxZ[i] - pz) * iz;
+
+		const T tEnter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+		const T tExit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+
+		const bool inside = (!parallelX || (px >= minX[i] && px <= maxX[i]))
+			&& (!parallelY || (py >= minY[i] && py <= maxY[i]))
+			&& (!parallelZ || (pz >= minZ[i] && pz <= maxZ[i]));
+
+		results[i] = inside && tEnter <= tExit;
+	}
+}
+
+template <typename T>
+inline void AABB3Batch<T>::IsIntersectingWith(const AABB3<T>& box, std::span<bool> results) const
+{
+	Assert(results.size() >= GetCount());
+
+	const size_t count = GetCount();
+	for (size_t i = 0; i < count; ++i)
+	{
+		results[i] = (minX[i] <= box.max.x) & (maxX[i] >= box.min.x)
+			& (minY[i] <= box.max.y) & (maxY[i] >= box.min.y)
+			& (minZ[i] <= box.max.z) & (maxZ[i] >= box.min.z);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "Assert.h"
+
+// Monotonic memory resource that keeps its chunks between uses. Deallocation is a no-op; memory is reclaimed by
+// rewinding to a marker or resetting, after which the same chunks are handed out again, so a warmed-up arena serves
+// repeated workloads without touching the upstream allocator. Not thread-safe: use one arena per thread.
+struct Arena : std::pmr::memory_resource
+{
+	struct Marker
+	{
+		size_t chunk = 0;
+		size_t offset = 0;
+	};
+
+	explicit Arena(const size_t initialCapacity = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+	~Arena() override;
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	Marker GetMarker() const;
+	void Rewind(const Marker& marker);
+	void Reset();
+
+	size_t GetCapacity() const;
+
+private:
+	struct Chunk
+	{
+		std::byte* data;
+		size_t size;
+	};
+
+	static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+	std::pmr::memory_resource* upstream;
+	std::vector<Chunk> chunks;
+	size_t initialCapacity;
+	Marker current;
+
+	void* do_allocate(const size_t bytes, const size_t alignment) override;
+	void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Rewinds an arena to where it was when the scope was entered.
+struct ArenaScope
+{
+	explicit ArenaScope(Arena& arena);
+	~ArenaScope();
+
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+	Arena& arena;
+	Arena::Marker marker;
+};
+
+// Per-thread arena for temporaries. Memory allocated after an ArenaScope is entered is handed out again once the scope
+// exits, so anything that must outlive a scope cannot come from the arena that scope rewinds. Functions that return
+// results in a caller-supplied resource therefore pass it here and get a scratch arena distinct from it; the caller may
+// then use GetScratchArena() itself as the output resource.
+Arena& GetScratchArena();
+Arena& GetScratchArena(const std::pmr::memory_resource* output);
+
+inline Arena::Arena(const size_t initialCapacity, std::pmr::memory_resource* upstream)
+	: upstream(upstream)
+	, initialCapacity(std::max<size_t>(initialCapacity, CHUNK_ALIGNMENT))
+{
+	Assert(upstream != nullptr);
+}
+
+inline Arena::~Arena()
+{
+	for (const Chunk& chunk : chunks)
+		upstream->deallocate(chunk.data, chunk.size, CHUNK_ALIGNMENT);
+}
+
+inline Arena::Marker Arena::GetMarker() const
+{
+	return current;
+}
+
+inline void Arena::Rewind(const Marker& marker)
+{
+	Assert(marker.chunk < current.chunk || (marker.chunk == current.chunk && marker.offset <= current.offset));
+	current = marker;
+}
+
+inline void Arena::Reset()
+{
+	current = {};
+}
+
+inline size_t Arena::GetCapacity() const
+{
+	size_t retval = 0;
+	for (const Chunk& chunk : chunks)
+		retval += chunk.size;
+
+	return retval;
+}
+
+inline void* Arena::do_allocate(const size_t bytes, const size_t alignment)
+{
+	for (;; ++current.chunk, current.offset = 0)
+	{
+		if (current.chunk == chunks.size())
+		{
+			const size_t size = std::max({ chunks.empty() ? initialCapacity : 2 * chunks.back().size, bytes + alignment });
+			chunks.push_back({ static_cast<std::byte*>(upstream->allocate(size, CHUNK_ALIGNMENT)), size });
+		}
+
+		const Chunk& chunk = chunks[current.chunk];
+		const uintptr_t address = reinterpret_cast<uintptr_t>(chunk.data) + current.offset;
+		const size_t offset = current.offset + ((alignment - address % alignment) % alignment);
+
+		if (offset + bytes <= chunk.size)
+		{
+			current.offset = offset + bytes;
+			return chunk.data + offset;
+		}
+	}
+}
+
+inline void Arena::do_deallocate(void*, const size_t, const size_t)
+{
+}
+
+inline bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+inline ArenaScope::ArenaScope(Arena& arena)
+	: arena(arena)
+	, marker(arena.GetMarker())
+{
+}
+
+inline ArenaScope::~ArenaScope()
+{
+	arena.Rewind(marker);
+}
+
+inline Arena& GetScratchArena()
+{
+	return GetScratchArena(nullptr);
+}
+
+inline Arena& GetScratchArena(const std::pmr::memory_resource* output)
+{
+	thread_local Arena arenas[2];
+	return output == &arenas[0] ? arenas[1] : arenas[0];
+}
\ No newline at end of file
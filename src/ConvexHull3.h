@@ -0,0 +1,530 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "Assert.h"
+#include "Instrumentation.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Plane3.h"
+#include "Mesh3.h"
+#include "ConvexVolume.h"
+
+// Quickhull. Triangles are wound counter-clockwise when seen from outside. Points closer to a face than the
+// numerical tolerance count as inside, so coplanar input never produces sliver faces. Input that does not span
+// three dimensions produces an empty hull.
+template <typename T>
+struct ConvexHull3
+{
+	explicit ConvexHull3(std::span<const Point3<T>> points, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	const Mesh3<T>& GetMesh() const;
+	ConvexVolume<T> ToConvexVolume(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+	bool IsEmpty() const;
+
+private:
+	struct Builder;
+
+	Mesh3<T> mesh;
+	std::pmr::vector<Plane3<T>> planes;
+};
+
+using ConvexHull3f = ConvexHull3<float>;
+using ConvexHull3d = ConvexHull3<double>;
+using ConvexHull3ld = ConvexHull3<long double>;
+
+// Faces and their three half-edges live in flat arrays indexed by face slot (edge 3f + i belongs to face f), and
+// each face's outside set is an intrusive list threaded through a per-point array. Deleted slots are recycled and
+// the pools live in the scratch arena, so building the hull allocates only when the arena grows.
+// Planes and distances are computed in at least double, against the rounding of that arithmetic: in float the normals
+// of the small faces of dense input lose their orientation, and a float-sized tolerance lets visibility disagree with
+// the geometry, so the horizon stops being a single loop. Each face scales the tolerance by its own conditioning.
+template <typename T>
+struct ConvexHull3<T>::Builder
+{
+	using Real = std::conditional_t<(sizeof(T) < sizeof(double)), double, T>;
+
+	static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+	struct Face
+	{
+		Vector3<Real> normal;
+		Real offset = 0;
+		Real tolerance = 0;
+		uint32_t outsideHead = INVALID;
+		uint32_t farthestPoint = INVALID;
+		Real farthestDistance = 0;
+		uint32_t stamp = 0;
+		bool isVisible = false;
+		bool isDeleted = false;
+	};
+
+	struct HorizonEdge
+	{
+		uint32_t origin;
+		uint32_t destination;
+		uint32_t twin;
+	};
+
+	std::span<const Point3<T>> input;
+	std::pmr::vector<Point3<Real>> widened;
+	std::span<const Point3<Real>> points;
+	Real tolerance = 0;
+
+	std::pmr::memory_resource* scratch;
+
+	std::pmr::vector<Face> faces;
+	std::pmr::vector<uint32_t> edgeOrigins;
+	std::pmr::vector<uint32_t> edgeTwins;
+	std::pmr::vector<uint32_t> freeFaces;
+	std::pmr::vector<uint32_t> nextOutside;
+
+	std::pmr::vector<uint32_t> pending;
+	std::pmr::vector<uint32_t> stack;
+	std::pmr::vector<uint32_t> visible;
+	std::pmr::vector<HorizonEdge> horizon;
+	std::pmr::vector<uint32_t> newFaces;
+	std::pmr::vector<uint32_t> orphans;
+	std::pmr::vector<uint32_t> faceByVertex;
+	uint32_t stamp = 0;
+
+	Builder(std::span<const Point3<T>> points, std::pmr::memory_resource* scratch);
+
+	bool BuildSimplex();
+	void Expand();
+	void Extract(Mesh3<T>& mesh, std::pmr::vector<Plane3<T>>& planes) const;
+
+	bool IsConvex() const;
+
+	uint32_t AddFace(const uint32_t a, const uint32_t b, const uint32_t c);
+	void AddOutside(const uint32_t face, const uint32_t point, const Real distance);
+	void AddPoint(const uint32_t eye, const uint32_t face);
+
+	Real DistanceTo(const uint32_t face, const uint32_t point) const;
+};
+
+template <typename T>
+inline ConvexHull3<T>::ConvexHull3(std::span<const Point3<T>> points, std::pmr::memory_resource* resource)
+	: mesh(resource)
+	, planes(resource)
+{
+	InstrumentScope(ConvexHull3Build);
+
+	Arena& scratch = GetScratchArena(resource);
+	const ArenaScope scope(scratch);
+
+	Builder builder(points, &scratch);
+	if (!builder.BuildSimplex()) return;
+
+	builder.Expand();
+#ifdef _DEBUG
+	Assert(builder.IsConvex());
+#endif
+
+	builder.Extract(mesh, planes);
+}
+
+template <typename T>
+inline const Mesh3<T>& ConvexHull3<T>::GetMesh() const
+{
+	return mesh;
+}
+
+template <typename T>
+inline ConvexVolume<T> ConvexHull3<T>::ToConvexVolume(std::pmr::memory_resource* resource) const
+{
+	// Built from the unit face normals the builder already has; recomputing them from the triangles would reject the
+	// small faces of dense or small-scale hulls against the absolute EPSILON.
+	return ConvexVolume<T>(planes, resource);
+}
+
+template <typename T>
+inline bool ConvexHull3<T>::IsEmpty() const
+{
+	return mesh.triangles.empty();
+}
+
+template <typename T>
+inline ConvexHull3<T>::Builder::Builder(std::span<const Point3<T>> points, std::pmr::memory_resource* scratch)
+	: input(points)
+	, widened(scratch)
+	, scratch(scratch)
+	, faces(scratch)
+	, edgeOrigins(scratch)
+	, edgeTwins(scratch)
+	, freeFaces(scratch)
+	, nextOutside(points.size(), INVALID, scratch)
+	, pending(scratch)
+	, stack(scratch)
+	, visible(scratch)
+	, horizon(scratch)
+	, newFaces(scratch)
+	, orphans(scratch)
+	, faceByVertex(scratch)
+{
+	if constexpr (std::is_same_v<T, Real>)
+	{
+		this->points = points;
+	}
+	else
+	{
+		widened.resize(points.size());
+		std::transform(std::execution::par_unseq, points.begin(), points.end(), widened.begin(),
+			[](const Point3<T>& point) { return Point3<Real>{ point.x, point.y, point.z }; });
+
+		this->points = widened;
+	}
+}
+
+template <typename T>
+inline bool ConvexHull3<T>::Builder::BuildSimplex()
+{
+	if (points.size() < 4) return false;
+
+	std::array<uint32_t, 6> extremes{};
+	Real maxAbs[3] = { 0, 0, 0 };
+
+	for (uint32_t i = 0; i < points.size(); ++i)
+	{
+		const Point3<Real>& p = points[i];
+		if (p.x < points[extremes[0]].x) extremes[0] = i;
+		if (p.x > points[extremes[1]].x) extremes[1] = i;
+		if (p.y < points[extremes[2]].y) extremes[2] = i;
+		if (p.y > points[extremes[3]].y) extremes[3] = i;
+		if (p.z < points[extremes[4]].z) extremes[4] = i;
+		if (p.z > points[extremes[5]].z) extremes[5] = i;
+
+		maxAbs[0] = std::max(maxAbs[0], std::abs(p.x));
+		maxAbs[1] = std::max(maxAbs[1], std::abs(p.y));
+		maxAbs[2] = std::max(maxAbs[2], std::abs(p.z));
+	}
+
+	tolerance = 3 * std::numeric_limits<Real>::epsilon() * (maxAbs[0] + maxAbs[1] + maxAbs[2]);
+
+	uint32_t a = 0, b = 0;
+	Real maxDistance = 0;
+
+	for (const uint32_t i : extremes)
+	{
+		for (const uint32_t j : extremes)
+		{
+			const Real distance = (points[j] - points[i]).MagnitudeSquared();
+			if (distance > maxDistance)
+			{
+				maxDistance = distance;
+				a = i;
+				b = j;
+			}
+		}
+	}
+
+	if (std::sqrt(maxDistance) <= tolerance) return false;
+
+	uint32_t c = 0;
+	maxDistance = 0;
+
+	const Vector3<Real> ab = points[b] - points[a];
+	for (uint32_t i = 0; i < points.size(); ++i)
+	{
+		const Real distance = ab.CrossProduct(points[i] - points[a]).MagnitudeSquared();
+		if (distance > maxDistance)
+		{
+			maxDistance = distance;
+			c = i;
+		}
+	}
+
+	if (std::sqrt(maxDistance) / ab.Magnitude() <= tolerance) return false;
+
+	uint32_t d = 0;
+	maxDistance = 0;
+
+	// Normalized by hand: Normalized() asserts against the absolute EPSILON, which small-scale input is below.
+	const Vector3<Real> crossProduct = ab.CrossProduct(points[c] - points[a]);
+	const Vector3<Real> normal = crossProduct / crossProduct.Magnitude();
+	for (uint32_t i = 0; i < points.size(); ++i)
+	{
+		const Real distance = std::abs(normal.DotProduct(points[i] - points[a]));
+		if (distance > maxDistance)
+		{
+			maxDistance = distance;
+			d = i;
+		}
+	}
+
+	if (maxDistance <= tolerance) return false;
+
+	if (normal.DotProduct(points[d] - points[a]) > 0)
+		std::swap(b, c);
+
+	AddFace(a, b, c);
+	AddFace(a, d, b);
+	AddFace(b, d, c);
+	AddFace(c, d, a);
+
+	for (uint32_t face = 0; face < 4; ++face)
+	{
+		for (uint32_t edge = 3 * face; edge < 3 * face + 3; ++edge)
+		{
+			const uint32_t origin = edgeOrigins[edge];
+			const uint32_t destination = edgeOrigins[edge % 3 == 2 ? edge - 2 : edge + 1];
+
+			for (uint32_t other = 0; other < 12; ++other)
+			{
+				if (edgeOrigins[other] == destination && edgeOrigins[other % 3 == 2 ? other - 2 : other + 1] == origin)
+					edgeTwins[edge] = other;
+			}
+		}
+	}
+
+	std::pmr::vector<std::pair<uint32_t, Real>> assignments(points.size(), scratch);
+	std::transform(std::execution::par_unseq, points.begin(), points.end(), assignments.begin(), [&](const Point3<Real>& point)
+	{
+		std::pair<uint32_t, Real> retval(INVALID, 0);
+		for (uint32_t face = 0; face < 4; ++face)
+		{
+			const Real distance = faces[face].normal.DotProduct(point.ToVector()) - faces[face].offset;
+			if (distance > faces[face].tolerance && distance > retval.second)
+				retval = { face, distance };
+		}
+
+		return retval;
+	});
+
+	for (uint32_t i = 0; i < points.size(); ++i)
+		if (assignments[i].first != INVALID)
+			AddOutside(assignments[i].first, i, assignments[i].second);
+
+	return true;
+}
+
+template <typename T>
+inline void ConvexHull3<T>::Builder::Expand()
+{
+	faceByVertex.assign(points.size(), INVALID);
+
+	for (uint32_t face = 0; face < 4; ++face)
+		if (faces[face].outsideHead != INVALID)
+			pending.push_back(face);
+
+	while (!pending.empty())
+	{
+		const uint32_t face = pending.back();
+		pending.pop_back();
+
+		if (faces[face].isDeleted || faces[face].outsideHead == INVALID) continue;
+
+		AddPoint(faces[face].farthestPoint, face);
+	}
+}
+
+template <typename T>
+inline void ConvexHull3<T>::Builder::Extract(Mesh3<T>& mesh, std::pmr::vector<Plane3<T>>& planes) const
+{
+	std::pmr::vector<uint32_t> remap(points.size(), INVALID, scratch);
+
+	for (uint32_t face = 0; face < faces.size(); ++face)
+	{
+		if (faces[face].isDeleted) continue;
+
+		std::array<uint32_t, 3> triangle;
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const uint32_t vertex = edgeOrigins[3 * face + i];
+			if (remap[vertex] == INVALID)
+			{
+				remap[vertex] = static_cast<uint32_t>(mesh.vertices.size());
+				mesh.vertices.push_back(input[vertex]);
+			}
+
+			triangle[i] = remap[vertex];
+		}
+
+		mesh.triangles.push_back(triangle);
+
+		const Vector3<Real>& normal = faces[face].normal;
+		if (!normal.IsZeroVector())
+			planes.emplace_back(input[edgeOrigins[3 * face]], Vector3<T>{ static_cast<T>(normal.x), static_cast<T>(normal.y), static_cast<T>(normal.z) });
+	}
+}
+
+template <typename T>
+inline bool ConvexHull3<T>::Builder::IsConvex() const
+{
+	// Every face must keep the far vertex of each neighbour behind it; an inverted face has them in front.
+	for (uint32_t face = 0; face < faces.size(); ++face)
+	{
+		if (faces[face].isDeleted) continue;
+
+		for (uint32_t edge = 3 * face; edge < 3 * face + 3; ++edge)
+		{
+			const uint32_t twin = edgeTwins[edge];
+			const uint32_t opposite = edgeOrigins[twin % 3 == 0 ? twin + 2 : twin - 1];
+
+			if (DistanceTo(face, opposite) > faces[face].tolerance)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename T>
+inline uint32_t ConvexHull3<T>::Builder::AddFace(const uint32_t a, const uint32_t b, const uint32_t c)
+{
+	uint32_t face;
+	if (freeFaces.empty())
+	{
+		face = static_cast<uint32_t>(faces.size());
+		faces.emplace_back();
+		edgeOrigins.resize(edgeOrigins.size() + 3);
+		edgeTwins.resize(edgeTwins.size() + 3, INVALID);
+	}
+	else
+	{
+		face = freeFaces.back();
+		freeFaces.pop_back();
+		faces[face] = Face();
+	}
+
+	edgeOrigins[3 * face] = a;
+	edgeOrigins[3 * face + 1] = b;
+	edgeOrigins[3 * face + 2] = c;
+
+	const Vector3<Real> ab = points[b] - points[a];
+	const Vector3<Real> ac = points[c] - points[a];
+	const Vector3<Real> crossProduct = ab.CrossProduct(ac);
+	const Real crossProductMagnitude = crossProduct.Magnitude();
+
+	faces[face].normal = crossProductMagnitude > 0 ? crossProduct / crossProductMagnitude : crossProduct;
+	faces[face].offset = faces[face].normal.DotProduct(points[a].ToVector());
+
+	// The normal's error grows as 1 / sin of the angle at a, so slivers only see points clearly in front of them.
+	faces[face].tolerance = crossProductMagnitude > 0
+		? tolerance * ab.Magnitude() * ac.Magnitude() / crossProductMagnitude
+		: std::numeric_limits<Real>::infinity();
+
+	return face;
+}
+
+template <typename T>
+inline void ConvexHull3<T>::Builder::AddOutside(const uint32_t face, const uint32_t point, const Real distance)
+{
+	Face& f = faces[face];
+	nextOutside[point] = f.outsideHead;
+	f.outsideHead = point;
+
+	if (f.farthestPoint == INVALID || distance > f.farthestDistance)
+	{
+		f.farthestPoint = point;
+		f.farthestDistance = distance;
+	}
+}
+
+template <typename T>
+inline void ConvexHull3<T>::Builder::AddPoint(const uint32_t eye, const uint32_t face)
+{
+	++stamp;
+	visible.clear();
+	horizon.clear();
+	newFaces.clear();
+	orphans.clear();
+
+	faces[face].stamp = stamp;
+	faces[face].isVisible = true;
+	stack.push_back(face);
+
+	while (!stack.empty())
+	{
+		const uint32_t current = stack.back();
+		stack.pop_back();
+		visible.push_back(current);
+
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const uint32_t edge = 3 * current + i;
+			const uint32_t twin = edgeTwins[edge];
+			Face& neighbor = faces[twin / 3];
+
+			if (neighbor.stamp != stamp)
+			{
+				neighbor.stamp = stamp;
+				neighbor.isVisible = DistanceTo(twin / 3, eye) > neighbor.tolerance;
+
+				if (neighbor.isVisible)
+					stack.push_back(twin / 3);
+			}
+
+			if (!neighbor.isVisible)
+				horizon.push_back({ edgeOrigins[edge], edgeOrigins[3 * current + (i + 1) % 3], twin });
+		}
+	}
+
+	for (const uint32_t current : visible)
+	{
+		for (uint32_t point = faces[current].outsideHead; point != INVALID; point = nextOutside[point])
+			if (point != eye)
+				orphans.push_back(point);
+
+		faces[current].isDeleted = true;
+		freeFaces.push_back(current);
+	}
+
+	for (const HorizonEdge& edge : horizon)
+	{
+		const uint32_t newFace = AddFace(edge.origin, edge.destination, eye);
+		edgeTwins[3 * newFace] = edge.twin;
+		edgeTwins[edge.twin] = 3 * newFace;
+
+		faceByVertex[edge.origin] = newFace;
+		newFaces.push_back(newFace);
+	}
+
+	for (const uint32_t newFace : newFaces)
+	{
+		const uint32_t next = faceByVertex[edgeOrigins[3 * newFace + 1]];
+		edgeTwins[3 * newFace + 1] = 3 * next + 2;
+		edgeTwins[3 * next + 2] = 3 * newFace + 1;
+	}
+
+	for (const uint32_t point : orphans)
+	{
+		uint32_t bestFace = INVALID;
+		Real bestDistance = 0;
+
+		for (const uint32_t newFace : newFaces)
+		{
+			const Real distance = DistanceTo(newFace, point);
+			if (distance > faces[newFace].tolerance && distance > bestDistance)
+			{
+				bestFace = newFace;
+				bestDistance = distance;
+			}
+		}
+
+		if (bestFace != INVALID)
+			AddOutside(bestFace, point, bestDistance);
+	}
+
+	for (const uint32_t newFace : newFaces)
+		if (faces[newFace].outsideHead != INVALID)
+			pending.push_back(newFace);
+}
+
+template <typename T>
+inline typename ConvexHull3<T>::Builder::Real ConvexHull3<T>::Builder::DistanceTo(const uint32_t face, const uint32_t point) const
+{
+	return faces[face].normal.DotProduct(points[point].ToVector()) - faces[face].offset;
+}
\ No newline at end of file
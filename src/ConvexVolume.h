@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "Assert.h"
+#include "Instrumentation.h"
+#include "Math.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Line3.h"
+#include "Plane3.h"
+#include "Simd.h"
+
+// Intersection of half-spaces with outward-facing normals. Normalized plane coefficients (ax + by + cz + d)
+// are kept in separate arrays so the per-plane loops stay branch-free and vectorizable.
+template <typename T>
+struct ConvexVolume
+{
+	explicit ConvexVolume(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	explicit ConvexVolume(std::span<const Plane3<T>> planes, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	static ConvexVolume Frustum(const Point3<T>& eye, const Vector3<T>& forward, const Vector3<T>& up,
+		const T verticalFov, const T aspectRatio, const T nearDistance, const T farDistance,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	void AddPlane(const Plane3<T>& plane);
+
+	size_t GetPlaneCount() const;
+	Plane3<T> GetPlane(const size_t index) const;
+
+	T RelativeDistanceTo(const Point3<T>& point) const;
+
+	bool ContainsPoint(const Point3<T>& point) const;
+	bool ContainsSphere(const Point3<T>& center, const T radius) const;
+	bool IsIntersectingWithSphere(const Point3<T>& center, const T radius) const;
+
+	void ContainsPoints(std::span<const Point3<T>> points, std::span<bool> results) const;
+	void ContainsSpheres(std::span<const Point3<T>> centers, std::span<const T> radii, std::span<bool> results) const;
+	void IsIntersectingWithSpheres(std::span<const Point3<T>> centers, std::span<const T> radii, std::span<bool> results) const;
+
+	std::optional<std::pair<T, T>> ClipLine(const Line3<T>& line, const T tMin = 0, const T tMax = 1) const;
+	std::pmr::vector<Point3<T>> ClipPolygon(std::span<const Point3<T>> polygon, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+	static constexpr size_t BATCH_SIZE = 256;
+
+	std::pmr::vector<T> a;
+	std::pmr::vector<T> b;
+	std::pmr::vector<T> c;
+	std::pmr::vector<T> d;
+
+	bool IsWithinAllPlanes(const Point3<T>& point, const T limit) const;
+
+	template <typename Function>
+	void ForEachRelativeDistanceTo(std::span<const Point3<T>> points, Function function) const;
+};
+
+using ConvexVolumef = ConvexVolume<float>;
+using ConvexVolumed = ConvexVolume<double>;
+using ConvexVolumeld = ConvexVolume<long double>;
+
+template <typename T>
+inline ConvexVolume<T>::ConvexVolume(std::pmr::memory_resource* resource)
+	: a(resource)
+	, b(resource)
+	, c(resource)
+	, d(resource)
+{
+}
+
+template <typename T>
+inline ConvexVolume<T>::ConvexVolume(std::span<const Plane3<T>> planes, std::pmr::memory_resource* resource)
+	: ConvexVolume(resource)
+{
+	a.reserve(planes.size());
+	b.reserve(planes.size());
+	c.reserve(planes.size());
+	d.reserve(planes.size());
+
+	for (const Plane3<T>& plane : planes)
+		AddPlane(plane);
+}
+
+template <typename T>
+inline ConvexVolume<T> ConvexVolume<T>::Frustum(const Point3<T>& eye, const Vector3<T>& forward, const Vector3<T>& up,
+	const T verticalFov, const T aspectRatio, const T nearDistance, const T farDistance,
+	std::pmr::memory_resource* resource)
+{
+	Assert(nearDistance > 0 && farDistance > nearDistance);
+
+	const Vector3<T> f = forward.Normalized();
+	const Vector3<T> r = f.CrossProduct(up).Normalized();
+	const Vector3<T> u = r.CrossProduct(f);
+
+	const T halfHeight = static_cast<T>(tan(verticalFov / 2));
+	const T halfWidth = halfHeight * aspectRatio;
+
+	const Plane3<T> planes[] =
+	{
+		{ eye + f * nearDistance, -f },
+		{ eye + f * farDistance, f },
+		{ eye, -r - f * halfWidth },
+		{ eye, r - f * halfWidth },
+		{ eye, u - f * halfHeight },
+		{ eye, -u - f * halfHeight }
+	};
+
+	return ConvexVolume(planes, resource);
+}
+
+template <typename T>
+inline void ConvexVolume<T>::AddPlane(const Plane3<T>& plane)
+{
+	const T normalMagnitude = plane.normal.Magnitude();
+	Assert(normalMagnitude > EPSILON);
+
+	const Vector3<T> normal = plane.normal / normalMagnitude;
+	a.push_back(normal.x);
+	b.push_back(normal.y);
+	c.push_back(normal.z);
+	d.push_back(-normal.DotProduct(plane.point.ToVector()));
+}
+
+template <typename T>
+inline size_t ConvexVolume<T>::GetPlaneCount() const
+{
+	return d.size();
+}
+
+template <typename T>
+inline Plane3<T> ConvexVolume<T>::GetPlane(const size_t index) const
+{
+	Assert(index < GetPlaneCount());
+	return { a[index], b[index], c[index], d[index] };
+}
+
+template <typename T>
+inline T ConvexVolume<T>::RelativeDistanceTo(const Point3<T>& point) const
+{
+	T maxDistance = -std::numeric_limits<T>::infinity();
+
+	const size_t planeCount = GetPlaneCount();
+	for (size_t i = 0; i < planeCount; ++i)
+		maxDistance = std::max(maxDistance, a[i] * point.x + b[i] * point.y + c[i] * point.z + d[i]);
+
+	return maxDistance;
+}
+
+template <typename T>
+inline bool ConvexVolume<T>::ContainsPoint(const Point3<T>& point) const
+{
+	return IsWithinAllPlanes(point, static_cast<T>(EPSILON));
+}
+
+template <typename T>
+inline bool ConvexVolume<T>::ContainsSphere(const Point3<T>& center, const T radius) const
+{
+	return IsWithinAllPlanes(center, static_cast<T>(EPSILON) - radius);
+}
+
+template <typename T>
+inline bool ConvexVolume<T>::IsIntersectingWithSphere(const Point3<T>& center, const T radius) const
+{
+	return IsWithinAllPlanes(center, static_cast<T>(EPSILON) + radius);
+}
+
+template <typename T>
+inline void ConvexVolume<T>::ContainsPoints(std::span<const Point3<T>> points, std::span<bool> results) const
+{
+	InstrumentScope(ConvexVolumeBatchQuery);
+	Assert(results.size() >= points.size());
+
+	ForEachRelativeDistanceTo(points, [&](const size_t i, const T distance) { results[i] = distance < EPSILON; });
+}
+
+template <typename T>
+inline void ConvexVolume<T>::ContainsSpheres(std::span<const Point3<T>> centers, std::span<const T> radii, std::span<bool> results) const
+{
+	InstrumentScope(ConvexVolumeBatchQuery);
+	Assert(radii.size() >= centers.size() && results.size() >= centers.size());
+
+	ForEachRelativeDistanceTo(centers, [&](const size_t i, const T distance) { results[i] = distance + radii[i] < EPSILON; });
+}
+
+template <typename T>
+inline void ConvexVolume<T>::IsIntersectingWithSpheres(std::span<const Point3<T>> centers, std::span<const T> radii, std::span<bool> results) const
+{
+	InstrumentScope(ConvexVolumeBatchQuery);
+	Assert(radii.size() >= centers.size() && results.size() >= centers.size());
+
+	ForEachRelativeDistanceTo(centers, [&](const size_t i, const T distance) { results[i] = distance - radii[i] < EPSILON; });
+}
+
+template <typename T>
+inline std::optional<std::pair<T, T>> ConvexVolume<T>::ClipLine(const Line3<T>& line, const T tMin, const T tMax) const
+{
+	T tEnter = tMin;
+	T tExit = tMax;
+
+	const size_t planeCount = GetPlaneCount();
+	for (size_t i = 0; i < planeCount; ++i)
+	{
+		const T distance = a[i] * line.point.x + b[i] * line.point.y + c[i] * line.point.z + d[i];
+		const T dotProduct = a[i] * line.direction.x + b[i] * line.direction.y + c[i] * line.direction.z;
+
+		if (IsZero(dotProduct))
+		{
+			if (distance > EPSILON) return {};
+			continue;
+		}
+
+		const T t = -distance / dotProduct;
+		if (dotProduct < 0)
+			tEnter = std::max(tEnter, t);
+		else
+			tExit = std::min(tExit, t);
+
+		if (tEnter > tExit) return {};
+	}
+
+	return { { tEnter, tExit } };
+}
+
+template <typename T>
+inline std::pmr::vector<Point3<T>> ConvexVolume<T>::ClipPolygon(std::span<const Point3<T>> polygon, std::pmr::memory_resource* resource) const
+{
+	InstrumentScope(ConvexVolumeClipPolygon);
+
+	Arena& scratch = GetScratchArena(resource);
+	const ArenaScope scope(scratch);
+
+	std::pmr::vector<Point3<T>> input(&scratch);
+	std::pmr::vector<Point3<T>> output(polygon.begin(), polygon.end(), &scratch);
+
+	const size_t planeCount = GetPlaneCount();
+	for (size_t i = 0; i < planeCount && !output.empty(); ++i)
+	{
+		std::swap(input, output);
+		output.clear();
+
+		// Measured from the plane pushed out by EPSILON, so that exactly the points ContainsPoint accepts are kept.
+		const auto distanceTo = [&](const Point3<T>& point)
+		{
+			return a[i] * point.x + b[i] * point.y + c[i] * point.z + d[i] - static_cast<T>(EPSILON);
+		};
+
+		const Point3<T>* previous = &input.back();
+		T previousDistance = distanceTo(*previous);
+
+		for (const Point3<T>& current : input)
+		{
+			const T currentDistance = distanceTo(current);
+
+			if ((previousDistance < 0) != (currentDistance < 0))
+			{
+				const T t = previousDistance / (previousDistance - currentDistance);
+				output.push_back(*previous + (current - *previous) * t);
+			}
+
+			if (currentDistance < 0)
+				output.push_back(current);
+
+			previous = &current;
+			previousDistance = currentDistance;
+		}
+	}
+
+	return std::pmr::vector<Point3<T>>(output.begin(), output.end(), resource);
+}
+
+template <typename T>
+inline bool ConvexVolume<T>::IsWithinAllPlanes(const Point3<T>& point, const T limit) const
+{
+	// An "any outside" mask rather than a max reduction, which compilers only vectorize under relaxed float semantics.
+	// The mask has the width of T so that comparison and reduction share one vector lane layout.
+	using Mask = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+	Mask outside = 0;
+
+	const size_t planeCount = GetPlaneCount();
+	for (size_t i = 0; i < planeCount; ++i)
+		outside |= a[i] * point.x + b[i] * point.y + c[i] * point.z + d[i] >= limit ? 1 : 0;
+
+	return outside == 0;
+}
+
+template <typename T>
+template <typename Function>
+inline void ConvexVolume<T>::ForEachRelativeDistanceTo(std::span<const Point3<T>> points, Function function) const
+{
+	// Each batch is transposed once so that every plane is a single call to the dispatched distance kernel.
+	const SimdKernels<T>& kernels = GetSimdKernels<T>();
+
+	T x[BATCH_SIZE], y[BATCH_SIZE], z[BATCH_SIZE];
+	T planeDistances[BATCH_SIZE];
+	T distances[BATCH_SIZE];
+	const size_t planeCount = GetPlaneCount();
+
+	for (size_t first = 0; first < points.size(); first += BATCH_SIZE)
+	{
+		const std::span<const Point3<T>> batch = points.subspan(first, std::min(BATCH_SIZE, points.size() - first));
+		for (size_t j = 0; j < batch.size(); ++j)
+		{
+			x[j] = batch[j].x;
+			y[j] = batch[j].y;
+			z[j] = batch[j].z;
+		}
+
+		std::fill_n(distances, batch.size(), -std::numeric_limits<T>::infinity());
+
+		for (size_t i = 0; i < planeCount; ++i)
+		{
+			kernels.RelativeDistanceTo(a[i], b[i], c[i], d[i], x, y, z, planeDistances, batch.size());
+
+			for (size_t j = 0; j < batch.size(); ++j)
+				distances[j] = std::max(distances[j], planeDistances[j]);
+		}
+
+		for (size_t j = 0; j < batch.size(); ++j)
+			function(first + j, distances[j]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "Assert.h"
+#include "Math.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Line3.h"
+#include "Plane3.h"
+
+// Opt-in approximations for angle and normalization queries that do not need full precision. FastRsqrt is within
+// 2 epsilon relative for float and 1e-10 for double; FastAcos and FastAsin are within 1e-7 radians plus two ulps of
+// PI. FastAngleBetween is within 1e-4 radians away from 0 and PI; between nearly parallel vectors acos turns the
+// rsqrt error e into about sqrt(8e) more. CheckFastMath in FastMathSelfCheck.h enforces these bounds. The batch
+// loops have no branches and vectorize at -O3, except that the double AngleThreshold one needs AVX2 to narrow its
+// comparison to bool.
+template <typename T>
+T FastRsqrt(const T value);
+
+template <typename T>
+T FastAcos(const T value);
+
+template <typename T>
+T FastAsin(const T value);
+
+template <typename T>
+Vector3<T> FastNormalized(const Vector3<T>& vector);
+
+template <typename T>
+T FastAngleBetween(const Vector3<T>& vector1, const Vector3<T>& vector2);
+
+template <typename T>
+T FastAngleBetween(const Line3<T>& line1, const Line3<T>& line2);
+
+template <typename T>
+T FastAngleBetween(const Plane3<T>& plane, const Line3<T>& line);
+
+template <typename T>
+T FastAngleBetween(const Plane3<T>& plane1, const Plane3<T>& plane2);
+
+template <typename T>
+void FastRsqrt(std::span<const T> values, std::span<T> results);
+
+template <typename T>
+void FastAcos(std::span<const T> values, std::span<T> results);
+
+template <typename T>
+void FastAsin(std::span<const T> values, std::span<T> results);
+
+template <typename T>
+void FastNormalize(std::span<const Vector3<T>> vectors, std::span<Vector3<T>> results);
+
+// Answers "is the angle between two vectors below a threshold" without trigonometry or square roots. The cosine of
+// the threshold is computed once; each query compares sign-preserving squares, which are monotonic, so the result
+// matches comparing AngleBetween against the threshold.
+template <typename T>
+struct AngleThreshold
+{
+	explicit AngleThreshold(const T angle);
+
+	T GetAngle() const;
+
+	bool IsAngleBelow(const Vector3<T>& vector1, const Vector3<T>& vector2) const;
+	void IsAngleBelow(const Vector3<T>& vector, std::span<const Vector3<T>> others, std::span<bool> results) const;
+
+private:
+	T angle;
+	T signedCosineSquared;
+
+	bool IsAngleBelow(const T dotProduct, const T magnitudesSquaredMultiplied) const;
+};
+
+using AngleThresholdf = AngleThreshold<float>;
+using AngleThresholdd = AngleThreshold<double>;
+using AngleThresholdld = AngleThreshold<long double>;
+
+template <typename T>
+inline T FastRsqrt(const T value)
+{
+	// Bit-level initial guess refined by Newton steps. Two steps already give 5e-6, but acos magnifies that to 3e-3
+	// radians for nearly parallel vectors, so a third one is taken.
+	if constexpr (std::is_same_v<T, float>)
+	{
+		T retval = std::bit_cast<float>(0x5F375A86u - (std::bit_cast<uint32_t>(value) >> 1));
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		return retval;
+	}
+	else if constexpr (std::is_same_v<T, double>)
+	{
+		T retval = std::bit_cast<double>(0x5FE6EB50C7B537A9ull - (std::bit_cast<uint64_t>(value) >> 1));
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		retval *= static_cast<T>(1.5) - static_cast<T>(0.5) * value * retval * retval;
+		return retval;
+	}
+	else
+	{
+		return 1 / std::sqrt(value);
+	}
+}
+
+template <typename T>
+inline T FastAcos(const T value)
+{
+	// Abramowitz and Stegun 4.4.46, evaluated on |value| and reflected for negative inputs. Written without branches
+	// or std::sqrt (which keeps errno semantics) so that the batch form vectorizes: sqrt(1 - x) is y * rsqrt(y) with
+	// y clamped to the smallest normal through (d + |d|) / 2, and the reflection selects both sides, since trapping
+	// math would not let the compiler if-convert a conditional subtraction.
+	const T x = std::abs(value);
+
+	T polynomial = static_cast<T>(-0.0012624911);
+	polynomial = polynomial * x + static_cast<T>(0.0066700901);
+	polynomial = polynomial * x + static_cast<T>(-0.0170881256);
+	polynomial = polynomial * x + static_cast<T>(0.0308918810);
+	polynomial = polynomial * x + static_cast<T>(-0.0501743046);
+	polynomial = polynomial * x + static_cast<T>(0.0889789874);
+	polynomial = polynomial * x + static_cast<T>(-0.2145988016);
+	polynomial = polynomial * x + static_cast<T>(1.5707963050);
+
+	const T d = 1 - x;
+	const T y = (d + std::abs(d)) / 2 + std::numeric_limits<T>::min();
+	const T retval = y * FastRsqrt(y) * polynomial;
+
+	const bool isNegative = value < 0;
+	return (isNegative ? static_cast<T>(PI) : 0) + (isNegative ? -retval : retval);
+}
+
+template <typename T>
+inline T FastAsin(const T value)
+{
+	return static_cast<T>(PI / 2) - FastAcos(value);
+}
+
+template <typename T>
+inline Vector3<T> FastNormalized(const Vector3<T>& vector)
+{
+	const T magnitudeSquared = vector.MagnitudeSquared();
+	Assert(magnitudeSquared > EPSILON * EPSILON);
+
+	return vector * FastRsqrt(magnitudeSquared);
+}
+
+template <typename T>
+inline T FastAngleBetween(const Vector3<T>& vector1, const Vector3<T>& vector2)
+{
+	const T magnitudesSquaredMultiplied = vector1.MagnitudeSquared() * vector2.MagnitudeSquared();
+	Assert(magnitudesSquaredMultiplied > EPSILON * EPSILON);
+
+	return FastAcos(vector1.DotProduct(vector2) * FastRsqrt(magnitudesSquaredMultiplied));
+}
+
+template <typename T>
+inline T FastAngleBetween(const Line3<T>& line1, const Line3<T>& line2)
+{
+	if (!line1.IsIntersectingWith(line2)) return 0;
+
+	const T magnitudesSquaredMultiplied = line1.direction.MagnitudeSquared() * line2.direction.MagnitudeSquared();
+	Assert(magnitudesSquaredMultiplied > EPSILON * EPSILON);
+
+	return FastAcos(std::abs(line1.direction.DotProduct(line2.direction)) * FastRsqrt(magnitudesSquaredMultiplied));
+}
+
+template <typename T>
+inline T FastAngleBetween(const Plane3<T>& plane, const Line3<T>& line)
+{
+	if (plane.IsParallelTo(line)) return 0;
+
+	const T magnitudesSquaredMultiplied = plane.normal.MagnitudeSquared() * line.direction.MagnitudeSquared();
+	Assert(magnitudesSquaredMultiplied > EPSILON * EPSILON);
+
+	return FastAsin(std::abs(plane.normal.DotProduct(line.direction)) * FastRsqrt(magnitudesSquaredMultiplied));
+}
+
+template <typename T>
+inline T FastAngleBetween(const Plane3<T>& plane1, const Plane3<T>& plane2)
+{
+	if (plane1.IsParallelTo(plane2)) return 0;
+
+	const T magnitudesSquaredMultiplied = plane1.normal.MagnitudeSquared() * plane2.normal.MagnitudeSquared();
+	Assert(magnitudesSquaredMultiplied > EPSILON * EPSILON);
+
+	return FastAcos(std::abs(plane1.normal.DotProduct(plane2.normal)) * FastRsqrt(magnitudesSquaredMultiplied));
+}
+
+template <typename T>
+inline void FastRsqrt(std::span<const T> values, std::span<T> results)
+{
+	Assert(results.size() >= values.size());
+
+	for (size_t i = 0; i < values.size(); ++i)
+		results[i] = FastRsqrt(values[i]);
+}
+
+template <typename T>
+inline void FastAcos(std::span<const T> values, std::span<T> results)
+{
+	Assert(results.size() >= values.size());
+
+	for (size_t i = 0; i < values.size(); ++i)
+		results[i] = FastAcos(values[i]);
+}
+
+template <typename T>
+inline void FastAsin(std::span<const T> values, std::span<T> results)
+{
+	Assert(results.size() >= values.size());
+
+	for (size_t i = 0; i < values.size(); ++i)
+		results[i] = FastAsin(values[i]);
+}
+
+template <typename T>
+inline void FastNormalize(std::span<const Vector3<T>> vectors, std::span<Vector3<T>> results)
+{
+	Assert(results.size() >= vectors.size());
+
+	for (size_t i = 0; i < vectors.size(); ++i)
+	{
+		const Vector3<T>& vector = vectors[i];
+		const T rsqrt = FastRsqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+		results[i] = { vector.x * rsqrt, vector.y * rsqrt, vector.z * rsqrt };
+	}
+}
+
+template <typename T>
+inline AngleThreshold<T>::AngleThreshold(const T angle)
+	: angle(angle)
+{
+	Assert(angle >= 0 && angle <= PI);
+
+	const T cosine = std::cos(angle);
+	signedCosineSquared = cosine * std::abs(cosine);
+}
+
+template <typename T>
+inline T AngleThreshold<T>::GetAngle() const
+{
+	return angle;
+}
+
+template <typename T>
+inline bool AngleThreshold<T>::IsAngleBelow(const Vector3<T>& vector1, const Vector3<T>& vector2) const
+{
+	return IsAngleBelow(vector1.DotProduct(vector2), vector1.MagnitudeSquared() * vector2.MagnitudeSquared());
+}
+
+template <typename T>
+inline void AngleThreshold<T>::IsAngleBelow(const Vector3<T>& vector, std::span<const Vector3<T>> others, std::span<bool> results) const
+{
+	Assert(results.size() >= others.size());
+
+	const T magnitudeSquared = vector.MagnitudeSquared();
+	for (size_t i = 0; i < others.size(); ++i)
+	{
+		const Vector3<T>& other = others[i];
+		const T dotProduct = vector.x * other.x + vector.y * other.y + vector.z * other.z;
+		const T otherMagnitudeSquared = other.x * other.x + other.y * other.y + other.z * other.z;
+		results[i] = IsAngleBelow(dotProduct, magnitudeSquared * otherMagnitudeSquared);
+	}
+}
+
+template <typename T>
+inline bool AngleThreshold<T>::IsAngleBelow(const T dotProduct, const T magnitudesSquaredMultiplied) const
+{
+	// cos(a) > cos(threshold) <=> dot > cos(threshold) * |u||v|, squared on both sides while keeping the signs.
+	return dotProduct * std::abs(dotProduct) > signedCosineSquared * magnitudesSquaredMultiplied;
+}
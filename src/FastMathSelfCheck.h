@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Assert.h"
+#include "Math.h"
+#include "Vector3.h"
+#include "FastMath.h"
+
+// Measures the FastMath approximations against long double references and fails when one exceeds the bound stated
+// in FastMath.h. Angles are checked both spread out and between nearly parallel vectors, where acos turns an input
+// error e into about sqrt(2e). Also reports how much faster the batch forms are than the standard library; the
+// timings are informational and never fail the check.
+template <typename T>
+bool CheckFastMath(std::ostream& stream);
+
+bool CheckFastMath(std::ostream& stream);
+
+template <typename T>
+inline bool CheckFastMath(std::ostream& stream)
+{
+	static constexpr size_t COUNT = 1 << 20;
+	const long double rsqrtBound = std::is_same_v<T, float> ? 2 * std::numeric_limits<float>::epsilon() : 1e-10L;
+	const long double acosBound = 1e-7L + 2 * PI * std::numeric_limits<T>::epsilon();
+	const long double angleBound = 1e-4L;
+	const long double parallelAngleBound = acosBound + std::sqrt(8 * rsqrtBound);
+
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> exponent(-30, 30);
+	std::uniform_real_distribution<double> unit(-1, 1);
+	std::normal_distribution<double> normal;
+
+	const auto exactAngle = [](const Vector3<T>& vector1, const Vector3<T>& vector2)
+	{
+		const long double x = static_cast<long double>(vector1.y) * vector2.z - static_cast<long double>(vector1.z) * vector2.y;
+		const long double y = static_cast<long double>(vector1.z) * vector2.x - static_cast<long double>(vector1.x) * vector2.z;
+		const long double z = static_cast<long double>(vector1.x) * vector2.y - static_cast<long double>(vector1.y) * vector2.x;
+		const long double dotProduct = static_cast<long double>(vector1.x) * vector2.x + static_cast<long double>(vector1.y) * vector2.y
+			+ static_cast<long double>(vector1.z) * vector2.z;
+
+		return std::atan2(std::sqrt(x * x + y * y + z * z), dotProduct);
+	};
+
+	long double rsqrtError = 0;
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const T value = static_cast<T>(std::pow(10.0, exponent(generator)));
+		const long double expected = 1 / std::sqrt(static_cast<long double>(value));
+		rsqrtError = std::max(rsqrtError, std::abs((FastRsqrt(value) - expected) / expected));
+	}
+
+	// Uniform values plus the last few hundred representable steps towards either end, where acos is steepest.
+	std::vector<T> values(COUNT);
+	for (T& value : values)
+		value = static_cast<T>(unit(generator));
+
+	for (size_t i = 0; i < 256; ++i)
+	{
+		values[2 * i] = 1 - i * std::numeric_limits<T>::epsilon() / 2;
+		values[2 * i + 1] = -values[2 * i];
+	}
+
+	std::vector<T> results(COUNT);
+	long double acosError = 0;
+
+	FastAcos<T>(values, results);
+	for (size_t i = 0; i < COUNT; ++i)
+		acosError = std::max(acosError, std::abs(results[i] - std::acos(static_cast<long double>(values[i]))));
+
+	FastAsin<T>(values, results);
+	for (size_t i = 0; i < COUNT; ++i)
+		acosError = std::max(acosError, std::abs(results[i] - std::asin(static_cast<long double>(values[i]))));
+
+	// Every other pair is nearly parallel; the thresholds are judged only where the exact angle is clearly on one side.
+	static constexpr double THRESHOLDS[] = { 0.01, 0.1, 0.5, 1, PI / 2, 2, 3 };
+	std::vector<AngleThreshold<T>> thresholds;
+	for (const double threshold : THRESHOLDS)
+		thresholds.emplace_back(static_cast<T>(threshold));
+
+	std::vector<Vector3<T>> vectors1(COUNT / 4), vectors2(COUNT / 4);
+	long double angleError = 0, parallelAngleError = 0;
+	size_t thresholdDisagreements = 0;
+
+	for (size_t i = 0; i < vectors1.size(); ++i)
+	{
+		const double spread = i % 2 == 0 ? 1 : 1e-3;
+		const Vector3<T> vector1{ static_cast<T>(normal(generator)), static_cast<T>(normal(generator)), static_cast<T>(normal(generator)) };
+		const Vector3<T> vector2{ static_cast<T>(vector1.x + spread * normal(generator)), static_cast<T>(vector1.y + spread * normal(generator)),
+			static_cast<T>(vector1.z + spread * normal(generator)) };
+
+		vectors1[i] = vector1;
+		vectors2[i] = vector2;
+
+		const long double expected = exactAngle(vector1, vector2);
+		const long double error = std::abs(FastAngleBetween(vector1, vector2) - expected);
+
+		if (expected < 0.01L || expected > PI - 0.01L)
+			parallelAngleError = std::max(parallelAngleError, error);
+		else
+			angleError = std::max(angleError, error);
+
+		for (const AngleThreshold<T>& threshold : thresholds)
+		{
+			if (std::abs(expected - threshold.GetAngle()) > parallelAngleBound
+				&& threshold.IsAngleBelow(vector1, vector2) != (expected < threshold.GetAngle()))
+				++thresholdDisagreements;
+		}
+	}
+
+	using Clock = std::chrono::steady_clock;
+	const auto time = [](const auto& function)
+	{
+		const Clock::time_point start = Clock::now();
+		function();
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	};
+
+	volatile T sink = 0;
+	const double libraryAcosTime = time([&]
+	{
+		for (size_t i = 0; i < COUNT; ++i)
+			results[i] = std::acos(values[i]);
+		sink = results[COUNT / 2];
+	});
+	const double fastAcosTime = time([&] { FastAcos<T>(values, results); sink = results[COUNT / 2]; });
+
+	std::vector<bool> isBelow(vectors2.size());
+	const double libraryThresholdTime = time([&]
+	{
+		for (size_t i = 0; i < vectors2.size(); ++i)
+			isBelow[i] = vectors1[0].AngleBetween(vectors2[i]) < thresholds[2].GetAngle();
+		sink = static_cast<T>(isBelow[vectors2.size() / 2]);
+	});
+
+	std::unique_ptr<bool[]> isBelowBatch(new bool[vectors2.size()]);
+	const double fastThresholdTime = time([&]
+	{
+		thresholds[2].IsAngleBelow(vectors1[0], vectors2, std::span<bool>(isBelowBatch.get(), vectors2.size()));
+		sink = static_cast<T>(isBelowBatch[vectors2.size() / 2]);
+	});
+
+	const bool retval = rsqrtError <= rsqrtBound && acosError <= acosBound && angleError <= angleBound
+		&& parallelAngleError <= parallelAngleBound && thresholdDisagreements == 0;
+
+	stream << "FastMath<" << (std::is_same_v<T, float> ? "float" : "double") << ">: "
+		<< "rsqrt " << static_cast<double>(rsqrtError) << " (bound " << static_cast<double>(rsqrtBound) << "), "
+		<< "acos/asin " << static_cast<double>(acosError) << " (" << static_cast<double>(acosBound) << "), "
+		<< "angle " << static_cast<double>(angleError) << " (" << static_cast<double>(angleBound) << "), "
+		<< "nearly parallel " << static_cast<double>(parallelAngleError) << " (" << static_cast<double>(parallelAngleBound) << "), "
+		<< "threshold disagreements " << thresholdDisagreements << "; "
+		<< "batch acos " << libraryAcosTime / fastAcosTime << "x, threshold " << libraryThresholdTime / fastThresholdTime << "x faster"
+		<< (retval ? "" : " -- OUT OF BOUNDS") << '\n';
+
+	return retval;
+}
+
+inline bool CheckFastMath(std::ostream& stream)
+{
+	const bool isFloatValid = CheckFastMath<float>(stream);
+	const bool isDoubleValid = CheckFastMath<double>(stream);
+
+	return isFloatValid && isDoubleValid;
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+// Opt-in operation counters. Define LINEAR_ALGEBRA_INSTRUMENTATION to count calls and interesting branches, and
+// additionally LINEAR_ALGEBRA_INSTRUMENTATION_TIMING to time instrumented scopes. Otherwise the macros expand to
+// nothing and their arguments are not evaluated.
+#ifdef LINEAR_ALGEBRA_INSTRUMENTATION
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+enum class InstrumentedOperation
+{
+	Vector3Normalized,
+	Vector3NormalizedDegenerate,
+	Vector3AngleBetween,
+	Vector3AngleBetweenDegenerate,
+	Line3PointOfIntersection,
+	Line3PointOfIntersectionParallel,
+	Line3PointOfIntersectionSkew,
+	Line3ClosestPoints,
+	Line3ClosestPointsParallel,
+	Line3AngleBetween,
+	Line3DistanceToPoint,
+	Plane3PointOfIntersection,
+	Plane3PointOfIntersectionRejected,
+	Plane3LineOfIntersection,
+	Plane3LineOfIntersectionParallel,
+	Plane3AngleBetween,
+	Plane3DistanceToPoint,
+	ConvexVolumeBatchQuery,
+	ConvexVolumeClipPolygon,
+	ConvexHull3Build,
+	MeshSlicerSlice,
+	Count
+};
+
+struct Instrumentation
+{
+	struct Entry
+	{
+		uint64_t calls = 0;
+		uint64_t nanoseconds = 0;
+	};
+
+	using Totals = std::array<Entry, static_cast<size_t>(InstrumentedOperation::Count)>;
+
+	struct ScopedTimer
+	{
+		explicit ScopedTimer(const InstrumentedOperation operation);
+		~ScopedTimer();
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		InstrumentedOperation operation;
+#ifdef LINEAR_ALGEBRA_INSTRUMENTATION_TIMING
+		std::chrono::steady_clock::time_point start;
+#endif
+	};
+
+	static void Increment(const InstrumentedOperation operation);
+	static void AddTime(const InstrumentedOperation operation, const uint64_t nanoseconds);
+
+	static Totals GetTotals();
+	static void Reset();
+
+	static void WriteJson(std::ostream& stream);
+	static void WriteCsv(std::ostream& stream);
+
+	static const char* GetName(const InstrumentedOperation operation);
+
+private:
+	// Only the owning thread writes its counters, so relaxed load/store pairs suffice and no increment is ever contended.
+	struct ThreadCounters
+	{
+		std::array<std::atomic<uint64_t>, static_cast<size_t>(InstrumentedOperation::Count)> calls{};
+		std::array<std::atomic<uint64_t>, static_cast<size_t>(InstrumentedOperation::Count)> nanoseconds{};
+	};
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadCounters>> threads;
+		Totals baseline{};
+	};
+
+	static Registry& GetRegistry();
+	static ThreadCounters& GetThreadCounters();
+	static Totals Sum();
+};
+
+inline Instrumentation::ScopedTimer::ScopedTimer(const InstrumentedOperation operation)
+	: operation(operation)
+#ifdef LINEAR_ALGEBRA_INSTRUMENTATION_TIMING
+	, start(std::chrono::steady_clock::now())
+#endif
+{
+	Increment(operation);
+}
+
+inline Instrumentation::ScopedTimer::~ScopedTimer()
+{
+#ifdef LINEAR_ALGEBRA_INSTRUMENTATION_TIMING
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	AddTime(operation, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+#endif
+}
+
+inline void Instrumentation::Increment(const InstrumentedOperation operation)
+{
+	std::atomic<uint64_t>& counter = GetThreadCounters().calls[static_cast<size_t>(operation)];
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline void Instrumentation::AddTime(const InstrumentedOperation operation, const uint64_t nanoseconds)
+{
+	std::atomic<uint64_t>& counter = GetThreadCounters().nanoseconds[static_cast<size_t>(operation)];
+	counter.store(counter.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+}
+
+inline Instrumentation::Totals Instrumentation::GetTotals()
+{
+	Registry& registry = GetRegistry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+
+	Totals retval = Sum();
+	for (size_t i = 0; i < retval.size(); ++i)
+	{
+		retval[i].calls -= registry.baseline[i].calls;
+		retval[i].nanoseconds -= registry.baseline[i].nanoseconds;
+	}
+
+	return retval;
+}
+
+inline void Instrumentation::Reset()
+{
+	Registry& registry = GetRegistry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+
+	registry.baseline = Sum();
+}
+
+inline void Instrumentation::WriteJson(std::ostream& stream)
+{
+	const Totals totals = GetTotals();
+
+	stream << "{\n";
+	for (size_t i = 0; i < totals.size(); ++i)
+	{
+		stream << "  \"" << GetName(static_cast<InstrumentedOperation>(i)) << "\": { \"calls\": " << totals[i].calls
+			<< ", \"nanoseconds\": " << totals[i].nanoseconds << " }" << (i + 1 < totals.size() ? ",\n" : "\n");
+	}
+	stream << "}\n";
+}
+
+inline void Instrumentation::WriteCsv(std::ostream& stream)
+{
+	const Totals totals = GetTotals();
+
+	stream << "operation,calls,nanoseconds\n";
+	for (size_t i = 0; i < totals.size(); ++i)
+		stream << GetName(static_cast<InstrumentedOperation>(i)) << ',' << totals[i].calls << ',' << totals[i].nanoseconds << '\n';
+}
+
+inline const char* Instrumentation::GetName(const InstrumentedOperation operation)
+{
+	static constexpr const char* names[] =
+	{
+		"Vector3::Normalized",
+		"Vector3::Normalized/degenerate",
+		"Vector3::AngleBetween",
+		"Vector3::AngleBetween/degenerate",
+		"Line3::PointOfIntersection",
+		"Line3::PointOfIntersection/parallel",
+		"Line3::PointOfIntersection/skew",
+		"Line3::GetClosestPointsWith",
+		"Line3::GetClosestPointsWith/parallel",
+		"Line3::AngleBetween",
+		"Line3::DistanceTo(Point3)",
+		"Plane3::PointOfIntersection",
+		"Plane3::PointOfIntersection/rejected",
+		"Plane3::LineOfIntersection",
+		"Plane3::LineOfIntersection/parallel",
+		"Plane3::AngleBetween",
+		"Plane3::DistanceTo(Point3)",
+		"ConvexVolume::batch query",
+		"ConvexVolume::ClipPolygon",
+		"ConvexHull3::ConvexHull3",
+		"MeshSlicer::Slice"
+	};
+	static_assert(std::size(names) == static_cast<size_t>(InstrumentedOperation::Count));
+
+	return names[static_cast<size_t>(operation)];
+}
+
+inline Instrumentation::Registry& Instrumentation::GetRegistry()
+{
+	static Registry registry;
+	return registry;
+}
+
+inline Instrumentation::ThreadCounters& Instrumentation::GetThreadCounters()
+{
+	// Counters outlive their thread so totals keep the work of threads that have already exited.
+	thread_local ThreadCounters* counters = []
+	{
+		Registry& registry = GetRegistry();
+		const std::lock_guard<std::mutex> lock(registry.mutex);
+
+		registry.threads.push_back(std::make_unique<ThreadCounters>());
+		return registry.threads.back().get();
+	}();
+
+	return *counters;
+}
+
+inline Instrumentation::Totals Instrumentation::Sum()
+{
+	Totals retval{};
+	for (const auto& thread : GetRegistry().threads)
+	{
+		for (size_t i = 0; i < retval.size(); ++i)
+		{
+			retval[i].calls += thread->calls[i].load(std::memory_order_relaxed);
+			retval[i].nanoseconds += thread->nanoseconds[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	return retval;
+}
+
+#define Instrument(operation) Instrumentation::Increment(InstrumentedOperation::operation)
+#define InstrumentIf(condition, operation) do { if (condition) Instrument(operation); } while (false)
+#define InstrumentScope(operation) const Instrumentation::ScopedTimer instrumentationTimer(InstrumentedOperation::operation)
+
+#else
+
+#define Instrument(operation)
+#define InstrumentIf(condition, operation)
+#define InstrumentScope(operation)
+
+#endif
\ No newline at end of file
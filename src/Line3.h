@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "Assert.h"
+#include "Instrumentation.h"
 #include "Math.h"
 #include "Point3.h"
 #include "Vector3.h"
@@ -60,15 +61,24 @@ inline Line3<T>::Line3(const Point3<T>& point1, const Point3<T>& point2)
 template <typename T>
 inline std::optional<Point3<T>> Line3<T>::PointOfIntersection(const Line3& other) const
 {
-	if (IsParallelTo(other)) return {};
+	Instrument(Line3PointOfIntersection);
+
+	if (IsParallelTo(other))
+	{
+		Instrument(Line3PointOfIntersectionParallel);
+		return {};
+	}
 
 	const auto closestPoints = GetClosestPointsWith(other);
+	InstrumentIf(closestPoints.first != closestPoints.second, Line3PointOfIntersectionSkew);
 	return closestPoints.first == closestPoints.second ? closestPoints.first : std::optional<Point3<T>>();
 }
 
 template <typename T>
 inline T Line3<T>::AngleBetween(const Line3& other) const
 {
+	Instrument(Line3AngleBetween);
+
 	if (!IsIntersectingWith(other)) return 0;
 
 	const T magnitudesMultiplied = direction.Magnitude() * other.direction.Magnitude();
@@ -80,6 +90,8 @@ inline T Line3<T>::AngleBetween(const Line3& other) const
 template <typename T>
 inline T Line3<T>::DistanceTo(const Point3<T>& point) const
 {
+	Instrument(Line3DistanceToPoint);
+
 	const T directionMagnitude = direction.Magnitude();
 	Assert(directionMagnitude > EPSILON);
 
@@ -141,6 +153,8 @@ inline bool Line3<T>::operator!=(const Line3& other) const
 template <typename T>
 inline std::pair<Point3<T>, Point3<T>> Line3<T>::GetClosestPointsWith(const Line3& other) const
 {
+	Instrument(Line3ClosestPoints);
+
 	const Vector3<T> crossProduct = direction.CrossProduct(other.direction);
 	const Vector3<T> vector = other.point - point;
 	T t1, t2;
@@ -162,6 +176,8 @@ inline std::pair<Point3<T>, Point3<T>> Line3<T>::GetClosestPointsWith(const Line
 	}
 	else
 	{
+		Instrument(Line3ClosestPointsParallel);
+
 		const T otherDirectionMagnitudeSquared = other.direction.MagnitudeSquared();
 		Assert(otherDirectionMagnitudeSquared > EPSILON);
 
@@ -17,7 +17,7 @@ CONST double EPSILON = 1e-5;
 template <typename T>
 inline bool IsZero(const T value)
 {
-	return abs(value) < EPSILON;
+	return std::abs(value) < EPSILON;
 }
 
 template <typename T>
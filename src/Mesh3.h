@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "Assert.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Plane3.h"
+#include "AABB3.h"
+
+template <typename T>
+struct Mesh3
+{
+	std::pmr::vector<Point3<T>> vertices;
+	std::pmr::vector<std::array<uint32_t, 3>> triangles;
+
+	explicit Mesh3(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	Mesh3(std::span<const Point3<T>> vertices, std::span<const std::array<uint32_t, 3>> triangles,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	size_t GetTriangleCount() const;
+
+	Plane3<T> GetTrianglePlane(const size_t index) const;
+	AABB3<T> GetBounds() const;
+};
+
+using Mesh3f = Mesh3<float>;
+using Mesh3d = Mesh3<double>;
+using Mesh3ld = Mesh3<long double>;
+
+template <typename T>
+inline Mesh3<T>::Mesh3(std::pmr::memory_resource* resource)
+	: vertices(resource)
+	, triangles(resource)
+{
+}
+
+template <typename T>
+inline Mesh3<T>::Mesh3(std::span<const Point3<T>> vertices, std::span<const std::array<uint32_t, 3>> triangles,
+	std::pmr::memory_resource* resource)
+	: vertices(vertices.begin(), vertices.end(), resource)
+	, triangles(triangles.begin(), triangles.end(), resource)
+{
+#ifdef _DEBUG
+	for (const auto& triangle : this->triangles)
+		for (const uint32_t index : triangle)
+			Assert(index < this->vertices.size());
+#endif
+}
+
+template <typename T>
+inline size_t Mesh3<T>::GetTriangleCount() const
+{
+	return triangles.size();
+}
+
+template <typename T>
+inline Plane3<T> Mesh3<T>::GetTrianglePlane(const size_t index) const
+{
+	Assert(index < GetTriangleCount());
+
+	const auto& triangle = triangles[index];
+	return { vertices[triangle[0]], vertices[triangle[1]], vertices[triangle[2]] };
+}
+
+template <typename T>
+inline AABB3<T> Mesh3<T>::GetBounds() const
+{
+	return AABB3<T>(vertices);
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Arena.h"
+#include "Assert.h"
+#include "Instrumentation.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Plane3.h"
+#include "Mesh3.h"
+
+template <typename T>
+struct Polyline3
+{
+	using allocator_type = std::pmr::polymorphic_allocator<Point3<T>>;
+
+	std::pmr::vector<Point3<T>> points;
+	bool isClosed = false;
+
+	Polyline3() = default;
+	explicit Polyline3(const allocator_type& allocator);
+	Polyline3(const Polyline3& other) = default;
+	Polyline3(const Polyline3& other, const allocator_type& allocator);
+	Polyline3(Polyline3&& other) = default;
+	Polyline3(Polyline3&& other, const allocator_type& allocator);
+
+	Polyline3& operator=(const Polyline3& other) = default;
+	Polyline3& operator=(Polyline3&& other) = default;
+};
+
+using Polyline3f = Polyline3<float>;
+using Polyline3d = Polyline3<double>;
+using Polyline3ld = Polyline3<long double>;
+
+// Cuts a mesh with a stack of parallel planes. Triangles are bucketed by the range of layers their extent along
+// the normal spans, then each layer is sliced independently. Segment endpoints are identified by mesh edge rather
+// than by position, so contours are stitched exactly and keep the winding of the mesh. A plane that only touches the
+// mesh, at a vertex, along an edge or across a face lying in it, without the mesh continuing to both sides yields no
+// contour. Temporaries live in the scratch arena of whichever thread slices a layer; only the returned polylines
+// come from the given resource.
+template <typename T>
+struct MeshSlicer
+{
+	explicit MeshSlicer(const Mesh3<T>& mesh);
+
+	std::pmr::vector<std::pmr::vector<Polyline3<T>>> Slice(std::span<const Plane3<T>> planes,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+	struct Segment
+	{
+		uint64_t startEdge;
+		uint64_t endEdge;
+	};
+
+	const Mesh3<T>& mesh;
+
+	std::pmr::vector<Polyline3<T>> SliceLayer(const T height, std::span<const uint32_t> triangles, std::span<const T> vertexHeights,
+		std::pmr::memory_resource* scratch) const;
+
+	static uint64_t GetEdgeKey(const uint32_t vertex1, const uint32_t vertex2);
+};
+
+using MeshSlicerf = MeshSlicer<float>;
+using MeshSlicerd = MeshSlicer<double>;
+using MeshSlicerld = MeshSlicer<long double>;
+
+template <typename T>
+inline Polyline3<T>::Polyline3(const allocator_type& allocator)
+	: points(allocator)
+{
+}
+
+template <typename T>
+inline Polyline3<T>::Polyline3(const Polyline3& other, const allocator_type& allocator)
+	: points(other.points, allocator)
+	, isClosed(other.isClosed)
+{
+}
+
+template <typename T>
+inline Polyline3<T>::Polyline3(Polyline3&& other, const allocator_type& allocator)
+	: points(std::move(other.points), allocator)
+	, isClosed(other.isClosed)
+{
+}
+
+template <typename T>
+inline MeshSlicer<T>::MeshSlicer(const Mesh3<T>& mesh)
+	: mesh(mesh)
+{
+}
+
+template <typename T>
+inline std::pmr::vector<std::pmr::vector<Polyline3<T>>> MeshSlicer<T>::Slice(std::span<const Plane3<T>> planes,
+	std::pmr::memory_resource* resource) const
+{
+	InstrumentScope(MeshSlicerSlice);
+
+	std::pmr::vector<std::pmr::vector<Polyline3<T>>> retval(planes.size(), resource);
+	if (planes.empty()) return retval;
+
+	Arena& scratch = GetScratchArena(resource);
+	const ArenaScope scope(scratch);
+
+	const Vector3<T>& normal = planes.front().normal;
+
+	std::pmr::vector<uint32_t> layers(planes.size(), &scratch);
+	std::iota(layers.begin(), layers.end(), 0);
+
+	std::pmr::vector<T> planeHeights(planes.size(), &scratch);
+	for (size_t i = 0; i < planes.size(); ++i)
+	{
+		Assert(planes[i].IsParallelTo(planes.front()));
+		planeHeights[i] = normal.DotProduct(planes[i].point.ToVector());
+	}
+
+	std::sort(layers.begin(), layers.end(), [&](const uint32_t lhs, const uint32_t rhs) { return planeHeights[lhs] < planeHeights[rhs]; });
+
+	std::pmr::vector<T> layerHeights(planes.size(), &scratch);
+	for (size_t i = 0; i < layers.size(); ++i)
+		layerHeights[i] = planeHeights[layers[i]];
+
+	std::pmr::vector<T> vertexHeights(mesh.vertices.size(), &scratch);
+	std::transform(std::execution::par_unseq, mesh.vertices.begin(), mesh.vertices.end(), vertexHeights.begin(),
+		[&](const Point3<T>& vertex) { return normal.DotProduct(vertex.ToVector()); });
+
+	// A triangle crosses a layer at height h when min < h <= max. Those with min == h rest on the layer from above and
+	// are kept too, so the layer can tell a mesh passing through a vertex from one only touching it: [first, last).
+	std::pmr::vector<std::pair<uint32_t, uint32_t>> layerRanges(mesh.triangles.size(), &scratch);
+	std::transform(std::execution::par_unseq, mesh.triangles.begin(), mesh.triangles.end(), layerRanges.begin(),
+		[&](const std::array<uint32_t, 3>& triangle)
+		{
+			const auto [min, max] = std::minmax({ vertexHeights[triangle[0]], vertexHeights[triangle[1]], vertexHeights[triangle[2]] });
+			const auto first = std::lower_bound(layerHeights.begin(), layerHeights.end(), min);
+			const auto last = std::upper_bound(first, layerHeights.end(), max);
+			return std::pair<uint32_t, uint32_t>(uint32_t(first - layerHeights.begin()), uint32_t(last - layerHeights.begin()));
+		});
+
+	std::pmr::vector<uint32_t> layerOffsets(layers.size() + 1, 0, &scratch);
+	for (const auto& [first, last] : layerRanges)
+		for (uint32_t layer = first; layer < last; ++layer)
+			++layerOffsets[layer + 1];
+
+	std::partial_sum(layerOffsets.begin(), layerOffsets.end(), layerOffsets.begin());
+
+	std::pmr::vector<uint32_t> layerTriangles(layerOffsets.back(), &scratch);
+	std::pmr::vector<uint32_t> layerFill(layerOffsets.begin(), layerOffsets.end() - 1, &scratch);
+	for (uint32_t triangle = 0; triangle < layerRanges.size(); ++triangle)
+		for (uint32_t layer = layerRanges[triangle].first; layer < layerRanges[triangle].second; ++layer)
+			layerTriangles[layerFill[layer]++] = triangle;
+
+	std::pmr::vector<uint32_t> sortedLayers(layers.size(), &scratch);
+	std::iota(sortedLayers.begin(), sortedLayers.end(), 0);
+
+	// The caller's resource need not be thread-safe, so results are copied out of the worker's arena under a lock.
+	std::mutex resourceMutex;
+	std::for_each(std::execution::par, sortedLayers.begin(), sortedLayers.end(), [&](const uint32_t layer)
+	{
+		Arena& layerScratch = GetScratchArena(resource);
+		const ArenaScope layerScope(layerScratch);
+
+		const std::span<const uint32_t> triangles(layerTriangles.data() + layerOffsets[layer], layerOffsets[layer + 1] - layerOffsets[layer]);
+		const auto polylines = SliceLayer(layerHeights[layer], triangles, vertexHeights, &layerScratch);
+
+		const std::lock_guard<std::mutex> lock(resourceMutex);
+		retval[layers[layer]].assign(polylines.begin(), polylines.end());
+	});
+
+	return retval;
+}
+
+template <typename T>
+inline std::pmr::vector<Polyline3<T>> MeshSlicer<T>::SliceLayer(const T height, std::span<const uint32_t> triangles, std::span<const T> vertexHeights,
+	std::pmr::memory_resource* scratch) const
+{
+	// Vertices lying exactly on the plane count as above it, so every crossed triangle has exactly one edge going
+	// down through the plane (the segment start) and one going up (the segment end). Triangles resting on the plane
+	// from above produce no segment; they only record the on-plane vertices the mesh continues above from.
+	std::pmr::vector<Segment> segments(scratch);
+	std::pmr::unordered_set<uint32_t> verticesContinuingAbove(scratch);
+	segments.reserve(triangles.size());
+
+	for (const uint32_t index : triangles)
+	{
+		const auto& triangle = mesh.triangles[index];
+		const auto [min, max] = std::minmax({ vertexHeights[triangle[0]], vertexHeights[triangle[1]], vertexHeights[triangle[2]] });
+
+		if (min >= height)
+		{
+			if (max > height)
+				for (const uint32_t vertex : triangle)
+					if (vertexHeights[vertex] == height)
+						verticesContinuingAbove.insert(vertex);
+
+			continue;
+		}
+
+		Segment segment{};
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const uint32_t vertex1 = triangle[i];
+			const uint32_t vertex2 = triangle[(i + 1) % 3];
+			const bool isAbove1 = vertexHeights[vertex1] >= height;
+			const bool isAbove2 = vertexHeights[vertex2] >= height;
+
+			if (isAbove1 && !isAbove2)
+				segment.startEdge = GetEdgeKey(vertex1, vertex2);
+			else if (!isAbove1 && isAbove2)
+				segment.endEdge = GetEdgeKey(vertex1, vertex2);
+		}
+
+		segments.push_back(segment);
+	}
+
+	std::pmr::unordered_map<uint64_t, uint32_t> segmentsByStart(scratch);
+	std::pmr::unordered_set<uint64_t> ends(scratch);
+	segmentsByStart.reserve(segments.size());
+	ends.reserve(segments.size());
+
+	for (uint32_t i = 0; i < segments.size(); ++i)
+	{
+		segmentsByStart.emplace(segments[i].startEdge, i);
+		ends.insert(segments[i].endEdge);
+	}
+
+	// Identifies where an edge meets the plane: the edge itself, or its endpoint when the plane passes exactly through
+	// a vertex. All edges incident to that vertex then share one key, so no positional tolerance is needed to merge them.
+	const auto getCrossingKey = [&](const uint64_t edge)
+	{
+		const uint32_t vertex1 = static_cast<uint32_t>(edge >> 32);
+		const uint32_t vertex2 = static_cast<uint32_t>(edge);
+
+		if (vertexHeights[vertex1] == height) return GetEdgeKey(vertex1, vertex1);
+		if (vertexHeights[vertex2] == height) return GetEdgeKey(vertex2, vertex2);
+		return edge;
+	};
+
+	const auto getCrossingPoint = [&](const uint64_t key)
+	{
+		const uint32_t vertex1 = static_cast<uint32_t>(key >> 32);
+		const uint32_t vertex2 = static_cast<uint32_t>(key);
+		if (vertex1 == vertex2) return mesh.vertices[vertex1];
+
+		const T t = (height - vertexHeights[vertex1]) / (vertexHeights[vertex2] - vertexHeights[vertex1]);
+		return mesh.vertices[vertex1] + (mesh.vertices[vertex2] - mesh.vertices[vertex1]) * t;
+	};
+
+	// Crossings at on-plane vertices the mesh does not continue above from; a contour made only of these touches the
+	// plane from below, which is dropped just as touching it from above produces nothing.
+	const auto isTouchingAt = [&](const uint64_t key)
+	{
+		const uint32_t vertex1 = static_cast<uint32_t>(key >> 32);
+		const uint32_t vertex2 = static_cast<uint32_t>(key);
+		return vertex1 == vertex2 && !verticesContinuingAbove.contains(vertex1);
+	};
+
+	std::pmr::vector<bool> isUsed(segments.size(), false, scratch);
+	std::pmr::vector<Polyline3<T>> retval(scratch);
+
+	const auto trace = [&](const uint32_t first)
+	{
+		Polyline3<T> polyline(scratch);
+		const uint64_t firstKey = getCrossingKey(segments[first].startEdge);
+		uint64_t lastKey = firstKey;
+		bool isTouching = isTouchingAt(firstKey);
+		polyline.points.push_back(getCrossingPoint(firstKey));
+
+		for (uint32_t current = first;;)
+		{
+			isUsed[current] = true;
+
+			const auto next = segmentsByStart.find(segments[current].endEdge);
+			if (next != segmentsByStart.end() && next->second == first)
+			{
+				if (polyline.points.size() > 1 && lastKey == firstKey)
+					polyline.points.pop_back();
+
+				polyline.isClosed = true;
+				break;
+			}
+
+			// Contours passing through a mesh vertex get a zero-length segment per incident edge.
+			const uint64_t key = getCrossingKey(segments[current].endEdge);
+			isTouching = isTouching && isTouchingAt(key);
+			if (key != lastKey)
+			{
+				polyline.points.push_back(getCrossingPoint(key));
+				lastKey = key;
+			}
+
+			if (next == segmentsByStart.end() || isUsed[next->second]) break;
+
+			current = next->second;
+		}
+
+		// A contour that collapsed to a single vertex has no length.
+		if (polyline.points.size() > 1 && !isTouching)
+			retval.push_back(std::move(polyline));
+	};
+
+	for (uint32_t i = 0; i < segments.size(); ++i)
+		if (!ends.contains(segments[i].startEdge))
+			trace(i);
+
+	for (uint32_t i = 0; i < segments.size(); ++i)
+		if (!isUsed[i])
+			trace(i);
+
+	return retval;
+}
+
+template <typename T>
+inline uint64_t MeshSlicer<T>::GetEdgeKey(const uint32_t vertex1, const uint32_t vertex2)
+{
+	return (static_cast<uint64_t>(std::min(vertex1, vertex2)) << 32) | std::max(vertex1, vertex2);
+}
\ No newline at end of file
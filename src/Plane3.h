@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "Assert.h"
+#include "Instrumentation.h"
 #include "Math.h"
 #include "Point3.h"
 #include "Vector3.h"
@@ -23,6 +24,11 @@ struct Plane3
 	std::optional<Point3<T>> PointOfIntersection(const Line3<T>& line) const;
 	std::optional<Line3<T>> LineOfIntersection(const Plane3& other) const;
 
+	// A point on the line shared by the planes n.p = normalDotPoint and otherNormal.p = otherNormalDotPoint, found by
+	// setting to zero the first coordinate whose component of the non-zero cross product is not zero.
+	static Point3<T> PointOnLineOfIntersection(const Vector3<T>& normal, const T normalDotPoint,
+		const Vector3<T>& otherNormal, const T otherNormalDotPoint, const Vector3<T>& crossProduct);
+
 	T AngleBetween(const Line3<T>& line) const;
 	T AngleBetween(const Plane3& other) const;
 
@@ -104,8 +110,14 @@ inline Plane3<T>::Plane3(const T a, const T b, const T c, const T d)
 template <typename T>
 inline std::optional<Point3<T>> Plane3<T>::PointOfIntersection(const Line3<T>& line) const
 {
+	Instrument(Plane3PointOfIntersection);
+
 	const T dotProduct = normal.DotProduct(line.direction);
-	if (dotProduct < EPSILON) return {};
+	if (dotProduct < EPSILON)
+	{
+		Instrument(Plane3PointOfIntersectionRejected);
+		return {};
+	}
 
 	const T t = -RelativeDistanceTo(line.point) / dotProduct;
 	const Point3<T> p = line.point + line.direction * t;
@@ -116,35 +128,51 @@ inline std::optional<Point3<T>> Plane3<T>::PointOfIntersection(const Line3<T>& l
 template <typename T>
 inline std::optional<Line3<T>> Plane3<T>::LineOfIntersection(const Plane3& other) const
 {
+	Instrument(Plane3LineOfIntersection);
+
 	const Vector3<T> crossProduct = normal.CrossProduct(other.normal);
-	if (crossProduct.IsZeroVector()) return {};
+	if (crossProduct.IsZeroVector())
+	{
+		Instrument(Plane3LineOfIntersectionParallel);
+		return {};
+	}
 
 	const T thisDotProduct = normal.DotProduct(point.ToVector());
 	const T otherDotProduct = other.normal.DotProduct(other.point.ToVector());
+
+	return { { PointOnLineOfIntersection(normal, thisDotProduct, other.normal, otherDotProduct, crossProduct), crossProduct } };
+}
+
+template <typename T>
+inline Point3<T> Plane3<T>::PointOnLineOfIntersection(const Vector3<T>& normal, const T normalDotPoint,
+	const Vector3<T>& otherNormal, const T otherNormalDotPoint, const Vector3<T>& crossProduct)
+{
 	Point3<T> point;
 
 	if (!IsZero(crossProduct.x))
 	{
-		point.y = (other.normal.z * thisDotProduct - normal.z * otherDotProduct) / crossProduct.x;
-		point.z = (other.normal.y * thisDotProduct - normal.y * otherDotProduct) / -crossProduct.x;
+		point.y = (otherNormal.z * normalDotPoint - normal.z * otherNormalDotPoint) / crossProduct.x;
+		point.z = (otherNormal.y * normalDotPoint - normal.y * otherNormalDotPoint) / -crossProduct.x;
 	}
 	else if (!IsZero(crossProduct.y))
 	{
-		point.x = (other.normal.z * thisDotProduct - normal.z * otherDotProduct) / -crossProduct.y;
-		point.z = (other.normal.x * thisDotProduct - normal.x * otherDotProduct) / crossProduct.y;
+		point.x = (otherNormal.z * normalDotPoint - normal.z * otherNormalDotPoint) / -crossProduct.y;
+		point.z = (otherNormal.x * normalDotPoint - normal.x * otherNormalDotPoint) / crossProduct.y;
 	}
 	else if (!IsZero(crossProduct.z))
 	{
-		point.x = (other.normal.y * thisDotProduct - normal.y * otherDotProduct) / crossProduct.z;
-		point.y = (other.normal.x * thisDotProduct - normal.x * otherDotProduct) / -crossProduct.z;
+		point.x = (otherNormal.y * normalDotPoint - normal.y * otherNormalDotPoint) / crossProduct.z;
+		point.y = (otherNormal.x * normalDotPoint - normal.x * otherNormalDotPoint) / -crossProduct.z;
 	}
 
-	return { { point , crossProduct } };
+	return point;
 }
 
 template <typename T>
 inline T Plane3<T>::AngleBetween(const Line3<T>& line) const
 {
+	Instrument(Plane3AngleBetween);
+
 	if (IsParallelTo(line)) return 0;
 
 	const T magnitudesMultiplied = normal.Magnitude() * line.direction.Magnitude();
@@ -156,6 +184,8 @@ inline T Plane3<T>::AngleBetween(const Line3<T>& line) const
 template <typename T>
 inline T Plane3<T>::AngleBetween(const Plane3& other) const
 {
+	Instrument(Plane3AngleBetween);
+
 	if (IsParallelTo(other)) return 0;
 
 	const T magnitudesMultiplied = normal.Magnitude() * other.normal.Magnitude();
@@ -173,6 +203,8 @@ inline T Plane3<T>::RelativeDistanceTo(const Point3<T>& point) const
 template <typename T>
 inline T Plane3<T>::DistanceTo(const Point3<T>& point) const
 {
+	Instrument(Plane3DistanceToPoint);
+
 	const T normalMagnitude = normal.Magnitude();
 	Assert(normalMagnitude > EPSILON);
 
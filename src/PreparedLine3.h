@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Assert.h"
+#include "Math.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Line3.h"
+
+// A line with its direction magnitude and unit direction computed once, for lines that are queried many times
+// between edits. The line can only be changed through the setters, which recompute the cached values, so queries
+// never see stale data and are safe to run concurrently.
+template <typename T>
+struct PreparedLine3
+{
+	explicit PreparedLine3(const Line3<T>& line);
+
+	const Line3<T>& GetLine() const;
+	const Vector3<T>& GetUnitDirection() const;
+	T GetDirectionMagnitude() const;
+
+	void SetLine(const Line3<T>& line);
+	void SetPoint(const Point3<T>& point);
+	void SetDirection(const Vector3<T>& direction);
+
+	T AngleBetween(const PreparedLine3& other) const;
+
+	T DistanceTo(const Point3<T>& point) const;
+	T DistanceSquaredTo(const Point3<T>& point) const;
+
+	Point3<T> ClosestPointTo(const Point3<T>& point) const;
+
+private:
+	Line3<T> line;
+	Vector3<T> unitDirection;
+	T directionMagnitude;
+
+	void Prepare();
+};
+
+using PreparedLine3f = PreparedLine3<float>;
+using PreparedLine3d = PreparedLine3<double>;
+using PreparedLine3ld = PreparedLine3<long double>;
+
+template <typename T>
+inline PreparedLine3<T>::PreparedLine3(const Line3<T>& line)
+	: line(line)
+{
+	Prepare();
+}
+
+template <typename T>
+inline const Line3<T>& PreparedLine3<T>::GetLine() const
+{
+	return line;
+}
+
+template <typename T>
+inline const Vector3<T>& PreparedLine3<T>::GetUnitDirection() const
+{
+	return unitDirection;
+}
+
+template <typename T>
+inline T PreparedLine3<T>::GetDirectionMagnitude() const
+{
+	return directionMagnitude;
+}
+
+template <typename T>
+inline void PreparedLine3<T>::SetLine(const Line3<T>& line)
+{
+	this->line = line;
+	Prepare();
+}
+
+template <typename T>
+inline void PreparedLine3<T>::SetPoint(const Point3<T>& point)
+{
+	line.point = point;
+}
+
+template <typename T>
+inline void PreparedLine3<T>::SetDirection(const Vector3<T>& direction)
+{
+	line.direction = direction;
+	Prepare();
+}
+
+template <typename T>
+inline T PreparedLine3<T>::AngleBetween(const PreparedLine3& other) const
+{
+	if (!line.IsIntersectingWith(other.line)) return 0;
+
+	return std::acos(std::min(std::abs(unitDirection.DotProduct(other.unitDirection)), static_cast<T>(1)));
+}
+
+template <typename T>
+inline T PreparedLine3<T>::DistanceTo(const Point3<T>& point) const
+{
+	return unitDirection.CrossProduct(point - line.point).Magnitude();
+}
+
+template <typename T>
+inline T PreparedLine3<T>::DistanceSquaredTo(const Point3<T>& point) const
+{
+	return unitDirection.CrossProduct(point - line.point).MagnitudeSquared();
+}
+
+template <typename T>
+inline Point3<T> PreparedLine3<T>::ClosestPointTo(const Point3<T>& point) const
+{
+	return line.point + unitDirection * unitDirection.DotProduct(point - line.point);
+}
+
+template <typename T>
+inline void PreparedLine3<T>::Prepare()
+{
+	directionMagnitude = line.direction.Magnitude();
+	Assert(directionMagnitude > EPSILON);
+
+	unitDirection = line.direction / directionMagnitude;
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "Assert.h"
+#include "Math.h"
+#include "Point3.h"
+#include "Vector3.h"
+#include "Line3.h"
+#include "Plane3.h"
+
+// A plane with its unit normal and constants computed once, for planes that are queried many times between edits.
+// The plane can only be changed through the setters, which recompute the cached values, so queries never see stale
+// data and are safe to run concurrently. Results match the corresponding Plane3 queries, except that
+// PointOfIntersection only rejects lines parallel to the plane, where Plane3 also rejects those whose direction
+// points against the normal.
+template <typename T>
+struct PreparedPlane3
+{
+	explicit PreparedPlane3(const Plane3<T>& plane);
+
+	const Plane3<T>& GetPlane() const;
+	const Vector3<T>& GetUnitNormal() const;
+	T GetNormalMagnitude() const;
+	T GetD() const;
+
+	void SetPlane(const Plane3<T>& plane);
+	void SetPoint(const Point3<T>& point);
+	void SetNormal(const Vector3<T>& normal);
+
+	std::optional<Point3<T>> PointOfIntersection(const Line3<T>& line) const;
+	std::optional<Line3<T>> LineOfIntersection(const PreparedPlane3& other) const;
+
+	T AngleBetween(const Line3<T>& line) const;
+	T AngleBetween(const PreparedPlane3& other) const;
+
+	T RelativeDistanceTo(const Point3<T>& point) const;
+	T SignedDistanceTo(const Point3<T>& point) const;
+
+	T DistanceTo(const Point3<T>& point) const;
+	T DistanceTo(const Line3<T>& line) const;
+	T DistanceTo(const PreparedPlane3& other) const;
+
+	bool IsPointInPlane(const Point3<T>& point) const;
+
+private:
+	Plane3<T> plane;
+	Vector3<T> unitNormal;
+	T normalMagnitude;
+	T normalDotPoint;
+	T d;
+
+	void Prepare();
+};
+
+using PreparedPlane3f = PreparedPlane3<float>;
+using PreparedPlane3d = PreparedPlane3<double>;
+using PreparedPlane3ld = PreparedPlane3<long double>;
+
+template <typename T>
+inline PreparedPlane3<T>::PreparedPlane3(const Plane3<T>& plane)
+	: plane(plane)
+{
+	Prepare();
+}
+
+template <typename T>
+inline const Plane3<T>& PreparedPlane3<T>::GetPlane() const
+{
+	return plane;
+}
+
+template <typename T>
+inline const Vector3<T>& PreparedPlane3<T>::GetUnitNormal() const
+{
+	return unitNormal;
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::GetNormalMagnitude() const
+{
+	return normalMagnitude;
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::GetD() const
+{
+	return d;
+}
+
+template <typename T>
+inline void PreparedPlane3<T>::SetPlane(const Plane3<T>& plane)
+{
+	this->plane = plane;
+	Prepare();
+}
+
+template <typename T>
+inline void PreparedPlane3<T>::SetPoint(const Point3<T>& point)
+{
+	plane.point = point;
+	normalDotPoint = plane.normal.DotProduct(point.ToVector());
+	d = -normalDotPoint / normalMagnitude;
+}
+
+template <typename T>
+inline void PreparedPlane3<T>::SetNormal(const Vector3<T>& normal)
+{
+	plane.normal = normal;
+	Prepare();
+}
+
+template <typename T>
+inline std::optional<Point3<T>> PreparedPlane3<T>::PointOfIntersection(const Line3<T>& line) const
+{
+	const T dotProduct = plane.normal.DotProduct(line.direction);
+	if (std::abs(dotProduct) < EPSILON) return {};
+
+	const T t = -RelativeDistanceTo(line.point) / dotProduct;
+	return line.point + line.direction * t;
+}
+
+template <typename T>
+inline std::optional<Line3<T>> PreparedPlane3<T>::LineOfIntersection(const PreparedPlane3& other) const
+{
+	const Vector3<T>& normal = plane.normal;
+	const Vector3<T>& otherNormal = other.plane.normal;
+
+	const Vector3<T> crossProduct = normal.CrossProduct(otherNormal);
+	if (crossProduct.IsZeroVector()) return {};
+
+	return { { Plane3<T>::PointOnLineOfIntersection(normal, normalDotPoint, otherNormal, other.normalDotPoint, crossProduct),
+		crossProduct } };
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::AngleBetween(const Line3<T>& line) const
+{
+	if (plane.IsParallelTo(line)) return 0;
+
+	const T directionMagnitude = line.direction.Magnitude();
+	Assert(directionMagnitude > EPSILON);
+
+	return std::asin(std::min(std::abs(unitNormal.DotProduct(line.direction)) / directionMagnitude, static_cast<T>(1)));
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::AngleBetween(const PreparedPlane3& other) const
+{
+	if (plane.IsParallelTo(other.plane)) return 0;
+
+	return std::acos(std::min(std::abs(unitNormal.DotProduct(other.unitNormal)), static_cast<T>(1)));
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::RelativeDistanceTo(const Point3<T>& point) const
+{
+	return plane.normal.DotProduct(point.ToVector()) - normalDotPoint;
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::SignedDistanceTo(const Point3<T>& point) const
+{
+	return unitNormal.DotProduct(point.ToVector()) + d;
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::DistanceTo(const Point3<T>& point) const
+{
+	return std::abs(SignedDistanceTo(point));
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::DistanceTo(const Line3<T>& line) const
+{
+	return plane.IsParallelTo(line) ? DistanceTo(line.point) : 0;
+}
+
+template <typename T>
+inline T PreparedPlane3<T>::DistanceTo(const PreparedPlane3& other) const
+{
+	return plane.IsParallelTo(other.plane) ? DistanceTo(other.plane.point) : 0;
+}
+
+template <typename T>
+inline bool PreparedPlane3<T>::IsPointInPlane(const Point3<T>& point) const
+{
+	return IsZero(RelativeDistanceTo(point));
+}
+
+template <typename T>
+inline void PreparedPlane3<T>::Prepare()
+{
+	normalMagnitude = plane.normal.Magnitude();
+	Assert(normalMagnitude > EPSILON);
+
+	unitNormal = plane.normal / normalMagnitude;
+	normalDotPoint = plane.normal.DotProduct(plane.point.ToVector());
+	d = -normalDotPoint / normalMagnitude;
+}
@@ -0,0 +1,632 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define SIMD_X86
+	#include <immintrin.h>
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define SIMD_TARGET(isa)
+	#else
+		#include <cpuid.h>
+		#define SIMD_TARGET(isa) __attribute__((target(isa)))
+	#endif
+#endif
+
+// Batched structure-of-arrays kernels compiled for several instruction sets in the same binary. The best level the
+// CPU supports is picked once, on first use; setting LINEAR_ALGEBRA_SIMD to scalar, sse2, avx2 or avx512 caps it.
+enum class SimdLevel
+{
+	Scalar,
+	Sse2,
+	Avx2,
+	Avx512
+};
+
+template <typename T>
+struct SimdKernels
+{
+	void (*DotProduct)(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* out, size_t count);
+	void (*CrossProduct)(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* outX, T* outY, T* outZ, size_t count);
+	void (*Normalize)(const T* x, const T* y, const T* z, T* outX, T* outY, T* outZ, size_t count);
+	void (*RelativeDistanceTo)(const T a, const T b, const T c, const T d, const T* x, const T* y, const T* z, T* out, size_t count);
+};
+
+SimdLevel GetSupportedSimdLevel();
+SimdLevel GetSimdLevel();
+const char* ToString(const SimdLevel level);
+
+template <typename T>
+const SimdKernels<T>& GetSimdKernels(const SimdLevel level);
+
+template <typename T>
+const SimdKernels<T>& GetSimdKernels();
+
+template <typename T>
+struct ScalarKernels
+{
+	static void DotProduct(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* out, size_t count);
+	static void CrossProduct(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* outX, T* outY, T* outZ, size_t count);
+	static void Normalize(const T* x, const T* y, const T* z, T* outX, T* outY, T* outZ, size_t count);
+	static void RelativeDistanceTo(const T a, const T b, const T c, const T d, const T* x, const T* y, const T* z, T* out, size_t count);
+};
+
+template <typename T>
+inline void ScalarKernels<T>::DotProduct(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+template <typename T>
+inline void ScalarKernels<T>::CrossProduct(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* outX, T* outY, T* outZ, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		const T x = ay[i] * bz[i] - az[i] * by[i];
+		const T y = az[i] * bx[i] - ax[i] * bz[i];
+		const T z = ax[i] * by[i] - ay[i] * bx[i];
+		outX[i] = x;
+		outY[i] = y;
+		outZ[i] = z;
+	}
+}
+
+template <typename T>
+inline void ScalarKernels<T>::Normalize(const T* x, const T* y, const T* z, T* outX, T* outY, T* outZ, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		const T magnitude = sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+		outX[i] = x[i] / magnitude;
+		outY[i] = y[i] / magnitude;
+		outZ[i] = z[i] / magnitude;
+	}
+}
+
+template <typename T>
+inline void ScalarKernels<T>::RelativeDistanceTo(const T a, const T b, const T c, const T d, const T* x, const T* y, const T* z, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = a * x[i] + b * y[i] + c * z[i] + d;
+}
+
+#ifdef SIMD_X86
+
+struct Sse2Kernels
+{
+	SIMD_TARGET("sse2") static void DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count);
+	SIMD_TARGET("sse2") static void DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count);
+	SIMD_TARGET("sse2") static void CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("sse2") static void CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("sse2") static void Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("sse2") static void Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("sse2") static void RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count);
+	SIMD_TARGET("sse2") static void RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count);
+};
+
+struct Avx2Kernels
+{
+	SIMD_TARGET("avx2,fma") static void DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count);
+	SIMD_TARGET("avx2,fma") static void DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count);
+	SIMD_TARGET("avx2,fma") static void CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("avx2,fma") static void CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("avx2,fma") static void Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("avx2,fma") static void Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("avx2,fma") static void RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count);
+	SIMD_TARGET("avx2,fma") static void RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count);
+};
+
+struct Avx512Kernels
+{
+	SIMD_TARGET("avx512f") static void DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count);
+	SIMD_TARGET("avx512f") static void DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count);
+	SIMD_TARGET("avx512f") static void CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("avx512f") static void CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("avx512f") static void Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count);
+	SIMD_TARGET("avx512f") static void Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count);
+	SIMD_TARGET("avx512f") static void RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count);
+	SIMD_TARGET("avx512f") static void RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count);
+};
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+		const __m128 y = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+		const __m128 z = _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i));
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(x, y), z));
+	}
+
+	ScalarKernels<float>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		const __m128d x = _mm_mul_pd(_mm_loadu_pd(ax + i), _mm_loadu_pd(bx + i));
+		const __m128d y = _mm_mul_pd(_mm_loadu_pd(ay + i), _mm_loadu_pd(by + i));
+		const __m128d z = _mm_mul_pd(_mm_loadu_pd(az + i), _mm_loadu_pd(bz + i));
+		_mm_storeu_pd(out + i, _mm_add_pd(_mm_add_pd(x, y), z));
+	}
+
+	ScalarKernels<double>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x1 = _mm_loadu_ps(ax + i), y1 = _mm_loadu_ps(ay + i), z1 = _mm_loadu_ps(az + i);
+		const __m128 x2 = _mm_loadu_ps(bx + i), y2 = _mm_loadu_ps(by + i), z2 = _mm_loadu_ps(bz + i);
+		_mm_storeu_ps(outX + i, _mm_sub_ps(_mm_mul_ps(y1, z2), _mm_mul_ps(z1, y2)));
+		_mm_storeu_ps(outY + i, _mm_sub_ps(_mm_mul_ps(z1, x2), _mm_mul_ps(x1, z2)));
+		_mm_storeu_ps(outZ + i, _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(y1, x2)));
+	}
+
+	ScalarKernels<float>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		const __m128d x1 = _mm_loadu_pd(ax + i), y1 = _mm_loadu_pd(ay + i), z1 = _mm_loadu_pd(az + i);
+		const __m128d x2 = _mm_loadu_pd(bx + i), y2 = _mm_loadu_pd(by + i), z2 = _mm_loadu_pd(bz + i);
+		_mm_storeu_pd(outX + i, _mm_sub_pd(_mm_mul_pd(y1, z2), _mm_mul_pd(z1, y2)));
+		_mm_storeu_pd(outY + i, _mm_sub_pd(_mm_mul_pd(z1, x2), _mm_mul_pd(x1, z2)));
+		_mm_storeu_pd(outZ + i, _mm_sub_pd(_mm_mul_pd(x1, y2), _mm_mul_pd(y1, x2)));
+	}
+
+	ScalarKernels<double>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+		const __m128 magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+		_mm_storeu_ps(outX + i, _mm_div_ps(vx, magnitude));
+		_mm_storeu_ps(outY + i, _mm_div_ps(vy, magnitude));
+		_mm_storeu_ps(outZ + i, _mm_div_ps(vz, magnitude));
+	}
+
+	ScalarKernels<float>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		const __m128d vx = _mm_loadu_pd(x + i), vy = _mm_loadu_pd(y + i), vz = _mm_loadu_pd(z + i);
+		const __m128d magnitude = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz)));
+		_mm_storeu_pd(outX + i, _mm_div_pd(vx, magnitude));
+		_mm_storeu_pd(outY + i, _mm_div_pd(vy, magnitude));
+		_mm_storeu_pd(outZ + i, _mm_div_pd(vz, magnitude));
+	}
+
+	ScalarKernels<double>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count)
+{
+	const __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b), vc = _mm_set1_ps(c), vd = _mm_set1_ps(d);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(x + i)), _mm_mul_ps(vb, _mm_loadu_ps(y + i))), _mm_mul_ps(vc, _mm_loadu_ps(z + i)));
+		_mm_storeu_ps(out + i, _mm_add_ps(distance, vd));
+	}
+
+	ScalarKernels<float>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+SIMD_TARGET("sse2") inline void Sse2Kernels::RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count)
+{
+	const __m128d va = _mm_set1_pd(a), vb = _mm_set1_pd(b), vc = _mm_set1_pd(c), vd = _mm_set1_pd(d);
+
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		const __m128d distance = _mm_add_pd(_mm_add_pd(_mm_mul_pd(va, _mm_loadu_pd(x + i)), _mm_mul_pd(vb, _mm_loadu_pd(y + i))), _mm_mul_pd(vc, _mm_loadu_pd(z + i)));
+		_mm_storeu_pd(out + i, _mm_add_pd(distance, vd));
+	}
+
+	ScalarKernels<double>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 dotProduct = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+		dotProduct = _mm256_fmadd_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i), dotProduct);
+		dotProduct = _mm256_fmadd_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i), dotProduct);
+		_mm256_storeu_ps(out + i, dotProduct);
+	}
+
+	ScalarKernels<float>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d dotProduct = _mm256_mul_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i));
+		dotProduct = _mm256_fmadd_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i), dotProduct);
+		dotProduct = _mm256_fmadd_pd(_mm256_loadu_pd(az + i), _mm256_loadu_pd(bz + i), dotProduct);
+		_mm256_storeu_pd(out + i, dotProduct);
+	}
+
+	ScalarKernels<double>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 x1 = _mm256_loadu_ps(ax + i), y1 = _mm256_loadu_ps(ay + i), z1 = _mm256_loadu_ps(az + i);
+		const __m256 x2 = _mm256_loadu_ps(bx + i), y2 = _mm256_loadu_ps(by + i), z2 = _mm256_loadu_ps(bz + i);
+		_mm256_storeu_ps(outX + i, _mm256_fmsub_ps(y1, z2, _mm256_mul_ps(z1, y2)));
+		_mm256_storeu_ps(outY + i, _mm256_fmsub_ps(z1, x2, _mm256_mul_ps(x1, z2)));
+		_mm256_storeu_ps(outZ + i, _mm256_fmsub_ps(x1, y2, _mm256_mul_ps(y1, x2)));
+	}
+
+	ScalarKernels<float>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m256d x1 = _mm256_loadu_pd(ax + i), y1 = _mm256_loadu_pd(ay + i), z1 = _mm256_loadu_pd(az + i);
+		const __m256d x2 = _mm256_loadu_pd(bx + i), y2 = _mm256_loadu_pd(by + i), z2 = _mm256_loadu_pd(bz + i);
+		_mm256_storeu_pd(outX + i, _mm256_fmsub_pd(y1, z2, _mm256_mul_pd(z1, y2)));
+		_mm256_storeu_pd(outY + i, _mm256_fmsub_pd(z1, x2, _mm256_mul_pd(x1, z2)));
+		_mm256_storeu_pd(outZ + i, _mm256_fmsub_pd(x1, y2, _mm256_mul_pd(y1, x2)));
+	}
+
+	ScalarKernels<double>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i), vz = _mm256_loadu_ps(z + i);
+		const __m256 magnitude = _mm256_sqrt_ps(_mm256_fmadd_ps(vz, vz, _mm256_fmadd_ps(vy, vy, _mm256_mul_ps(vx, vx))));
+		_mm256_storeu_ps(outX + i, _mm256_div_ps(vx, magnitude));
+		_mm256_storeu_ps(outY + i, _mm256_div_ps(vy, magnitude));
+		_mm256_storeu_ps(outZ + i, _mm256_div_ps(vz, magnitude));
+	}
+
+	ScalarKernels<float>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m256d vx = _mm256_loadu_pd(x + i), vy = _mm256_loadu_pd(y + i), vz = _mm256_loadu_pd(z + i);
+		const __m256d magnitude = _mm256_sqrt_pd(_mm256_fmadd_pd(vz, vz, _mm256_fmadd_pd(vy, vy, _mm256_mul_pd(vx, vx))));
+		_mm256_storeu_pd(outX + i, _mm256_div_pd(vx, magnitude));
+		_mm256_storeu_pd(outY + i, _mm256_div_pd(vy, magnitude));
+		_mm256_storeu_pd(outZ + i, _mm256_div_pd(vz, magnitude));
+	}
+
+	ScalarKernels<double>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count)
+{
+	const __m256 va = _mm256_set1_ps(a), vb = _mm256_set1_ps(b), vc = _mm256_set1_ps(c), vd = _mm256_set1_ps(d);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 distance = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), vd);
+		distance = _mm256_fmadd_ps(vb, _mm256_loadu_ps(y + i), distance);
+		distance = _mm256_fmadd_ps(vc, _mm256_loadu_ps(z + i), distance);
+		_mm256_storeu_ps(out + i, distance);
+	}
+
+	ScalarKernels<float>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx2,fma") inline void Avx2Kernels::RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count)
+{
+	const __m256d va = _mm256_set1_pd(a), vb = _mm256_set1_pd(b), vc = _mm256_set1_pd(c), vd = _mm256_set1_pd(d);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d distance = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), vd);
+		distance = _mm256_fmadd_pd(vb, _mm256_loadu_pd(y + i), distance);
+		distance = _mm256_fmadd_pd(vc, _mm256_loadu_pd(z + i), distance);
+		_mm256_storeu_pd(out + i, distance);
+	}
+
+	ScalarKernels<double>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::DotProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m512 dotProduct = _mm512_mul_ps(_mm512_loadu_ps(ax + i), _mm512_loadu_ps(bx + i));
+		dotProduct = _mm512_fmadd_ps(_mm512_loadu_ps(ay + i), _mm512_loadu_ps(by + i), dotProduct);
+		dotProduct = _mm512_fmadd_ps(_mm512_loadu_ps(az + i), _mm512_loadu_ps(bz + i), dotProduct);
+		_mm512_storeu_ps(out + i, dotProduct);
+	}
+
+	ScalarKernels<float>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::DotProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d dotProduct = _mm512_mul_pd(_mm512_loadu_pd(ax + i), _mm512_loadu_pd(bx + i));
+		dotProduct = _mm512_fmadd_pd(_mm512_loadu_pd(ay + i), _mm512_loadu_pd(by + i), dotProduct);
+		dotProduct = _mm512_fmadd_pd(_mm512_loadu_pd(az + i), _mm512_loadu_pd(bz + i), dotProduct);
+		_mm512_storeu_pd(out + i, dotProduct);
+	}
+
+	ScalarKernels<double>::DotProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::CrossProduct(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m512 x1 = _mm512_loadu_ps(ax + i), y1 = _mm512_loadu_ps(ay + i), z1 = _mm512_loadu_ps(az + i);
+		const __m512 x2 = _mm512_loadu_ps(bx + i), y2 = _mm512_loadu_ps(by + i), z2 = _mm512_loadu_ps(bz + i);
+		_mm512_storeu_ps(outX + i, _mm512_fmsub_ps(y1, z2, _mm512_mul_ps(z1, y2)));
+		_mm512_storeu_ps(outY + i, _mm512_fmsub_ps(z1, x2, _mm512_mul_ps(x1, z2)));
+		_mm512_storeu_ps(outZ + i, _mm512_fmsub_ps(x1, y2, _mm512_mul_ps(y1, x2)));
+	}
+
+	ScalarKernels<float>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::CrossProduct(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m512d x1 = _mm512_loadu_pd(ax + i), y1 = _mm512_loadu_pd(ay + i), z1 = _mm512_loadu_pd(az + i);
+		const __m512d x2 = _mm512_loadu_pd(bx + i), y2 = _mm512_loadu_pd(by + i), z2 = _mm512_loadu_pd(bz + i);
+		_mm512_storeu_pd(outX + i, _mm512_fmsub_pd(y1, z2, _mm512_mul_pd(z1, y2)));
+		_mm512_storeu_pd(outY + i, _mm512_fmsub_pd(z1, x2, _mm512_mul_pd(x1, z2)));
+		_mm512_storeu_pd(outZ + i, _mm512_fmsub_pd(x1, y2, _mm512_mul_pd(y1, x2)));
+	}
+
+	ScalarKernels<double>::CrossProduct(ax + i, ay + i, az + i, bx + i, by + i, bz + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+// GCC 12 reports the undefined source operand _mm512_sqrt_ps/pd pass to their masked builtin as maybe uninitialized.
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::Normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m512 vx = _mm512_loadu_ps(x + i), vy = _mm512_loadu_ps(y + i), vz = _mm512_loadu_ps(z + i);
+		const __m512 magnitude = _mm512_sqrt_ps(_mm512_fmadd_ps(vz, vz, _mm512_fmadd_ps(vy, vy, _mm512_mul_ps(vx, vx))));
+		_mm512_storeu_ps(outX + i, _mm512_div_ps(vx, magnitude));
+		_mm512_storeu_ps(outY + i, _mm512_div_ps(vy, magnitude));
+		_mm512_storeu_ps(outZ + i, _mm512_div_ps(vz, magnitude));
+	}
+
+	ScalarKernels<float>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::Normalize(const double* x, const double* y, const double* z, double* outX, double* outY, double* outZ, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m512d vx = _mm512_loadu_pd(x + i), vy = _mm512_loadu_pd(y + i), vz = _mm512_loadu_pd(z + i);
+		const __m512d magnitude = _mm512_sqrt_pd(_mm512_fmadd_pd(vz, vz, _mm512_fmadd_pd(vy, vy, _mm512_mul_pd(vx, vx))));
+		_mm512_storeu_pd(outX + i, _mm512_div_pd(vx, magnitude));
+		_mm512_storeu_pd(outY + i, _mm512_div_pd(vy, magnitude));
+		_mm512_storeu_pd(outZ + i, _mm512_div_pd(vz, magnitude));
+	}
+
+	ScalarKernels<double>::Normalize(x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::RelativeDistanceTo(const float a, const float b, const float c, const float d, const float* x, const float* y, const float* z, float* out, size_t count)
+{
+	const __m512 va = _mm512_set1_ps(a), vb = _mm512_set1_ps(b), vc = _mm512_set1_ps(c), vd = _mm512_set1_ps(d);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m512 distance = _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), vd);
+		distance = _mm512_fmadd_ps(vb, _mm512_loadu_ps(y + i), distance);
+		distance = _mm512_fmadd_ps(vc, _mm512_loadu_ps(z + i), distance);
+		_mm512_storeu_ps(out + i, distance);
+	}
+
+	ScalarKernels<float>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+SIMD_TARGET("avx512f") inline void Avx512Kernels::RelativeDistanceTo(const double a, const double b, const double c, const double d, const double* x, const double* y, const double* z, double* out, size_t count)
+{
+	const __m512d va = _mm512_set1_pd(a), vb = _mm512_set1_pd(b), vc = _mm512_set1_pd(c), vd = _mm512_set1_pd(d);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m512d distance = _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), vd);
+		distance = _mm512_fmadd_pd(vb, _mm512_loadu_pd(y + i), distance);
+		distance = _mm512_fmadd_pd(vc, _mm512_loadu_pd(z + i), distance);
+		_mm512_storeu_pd(out + i, distance);
+	}
+
+	ScalarKernels<double>::RelativeDistanceTo(a, b, c, d, x + i, y + i, z + i, out + i, count - i);
+}
+
+inline void Cpuid(int info[4], const int leaf, const int subleaf)
+{
+#ifdef _MSC_VER
+	__cpuidex(info, leaf, subleaf);
+#else
+	unsigned int registers[4];
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+	for (size_t i = 0; i < 4; ++i)
+		info[i] = static_cast<int>(registers[i]);
+#endif
+}
+
+inline unsigned long long Xgetbv()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+inline SimdLevel GetSupportedSimdLevel()
+{
+#ifdef SIMD_X86
+	int info[4];
+	Cpuid(info, 0, 0);
+	const int maxLeaf = info[0];
+
+	Cpuid(info, 1, 0);
+	const bool hasSse2 = (info[3] & (1 << 26)) != 0;
+	const bool hasFma = (info[2] & (1 << 12)) != 0;
+	const bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+	const bool hasAvx = (info[2] & (1 << 28)) != 0;
+
+	if (!hasSse2) return SimdLevel::Scalar;
+	if (!hasOsxsave || !hasAvx || maxLeaf < 7) return SimdLevel::Sse2;
+
+	// The OS has to save the wider registers on context switches, not just the CPU support them.
+	const unsigned long long enabledStates = Xgetbv();
+	if ((enabledStates & 0x6) != 0x6) return SimdLevel::Sse2;
+
+	Cpuid(info, 7, 0);
+	const bool hasAvx2 = (info[1] & (1 << 5)) != 0;
+	const bool hasAvx512 = (info[1] & (1 << 16)) != 0;
+
+	if (!hasAvx2 || !hasFma) return SimdLevel::Sse2;
+	if (!hasAvx512 || (enabledStates & 0xE6) != 0xE6) return SimdLevel::Avx2;
+
+	return SimdLevel::Avx512;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+inline SimdLevel GetSimdLevel()
+{
+	static const SimdLevel level = []
+	{
+		const SimdLevel supported = GetSupportedSimdLevel();
+
+		char* value = nullptr;
+#ifdef _MSC_VER
+		size_t size = 0;
+		if (_dupenv_s(&value, &size, "LINEAR_ALGEBRA_SIMD") != 0) value = nullptr;
+#else
+		value = std::getenv("LINEAR_ALGEBRA_SIMD");
+#endif
+		if (!value) return supported;
+
+		SimdLevel requested = supported;
+		for (const SimdLevel candidate : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512 })
+			if (std::string_view(value) == ToString(candidate))
+				requested = candidate;
+
+#ifdef _MSC_VER
+		free(value);
+#endif
+		return requested < supported ? requested : supported;
+	}();
+
+	return level;
+}
+
+inline const char* ToString(const SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Sse2: return "sse2";
+	case SimdLevel::Avx2: return "avx2";
+	case SimdLevel::Avx512: return "avx512";
+	default: return "scalar";
+	}
+}
+
+template <typename T>
+inline const SimdKernels<T>& GetSimdKernels(const SimdLevel level)
+{
+	static constexpr SimdKernels<T> scalar{ &ScalarKernels<T>::DotProduct, &ScalarKernels<T>::CrossProduct, &ScalarKernels<T>::Normalize, &ScalarKernels<T>::RelativeDistanceTo };
+
+#ifdef SIMD_X86
+	if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+	{
+		static constexpr SimdKernels<T> sse2{ &Sse2Kernels::DotProduct, &Sse2Kernels::CrossProduct, &Sse2Kernels::Normalize, &Sse2Kernels::RelativeDistanceTo };
+		static constexpr SimdKernels<T> avx2{ &Avx2Kernels::DotProduct, &Avx2Kernels::CrossProduct, &Avx2Kernels::Normalize, &Avx2Kernels::RelativeDistanceTo };
+		static constexpr SimdKernels<T> avx512{ &Avx512Kernels::DotProduct, &Avx512Kernels::CrossProduct, &Avx512Kernels::Normalize, &Avx512Kernels::RelativeDistanceTo };
+
+		switch (level)
+		{
+		case SimdLevel::Sse2: return sse2;
+		case SimdLevel::Avx2: return avx2;
+		case SimdLevel::Avx512: return avx512;
+		default: break;
+		}
+	}
+#endif
+
+	return scalar;
+}
+
+template <typename T>
+inline const SimdKernels<T>& GetSimdKernels()
+{
+	static const SimdKernels<T>& kernels = GetSimdKernels<T>(GetSimdLevel());
+	return kernels;
+}
\ No newline at end of file
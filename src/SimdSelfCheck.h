@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "Simd.h"
+
+// Runs every kernel at every instruction set the CPU supports against the scalar kernels and reports mismatches.
+// Lengths around the vector widths exercise the scalar tails. Inputs stay within [-1, 1] (and away from zero length
+// for Normalize), so a few ulps of absolute tolerance covers the rounding differences FMA contraction introduces.
+template <typename T>
+bool CheckSimdKernels(std::ostream& stream);
+
+bool CheckSimdKernels(std::ostream& stream);
+
+template <typename T>
+inline bool CheckSimdKernels(std::ostream& stream)
+{
+	static constexpr size_t COUNTS[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 1000 };
+	static constexpr size_t MAX_COUNT = 1000;
+	const T tolerance = 64 * std::numeric_limits<T>::epsilon();
+
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<T> value(-1, 1);
+	std::uniform_real_distribution<T> positive(static_cast<T>(0.5), 1);
+
+	std::vector<T> ax(MAX_COUNT), ay(MAX_COUNT), az(MAX_COUNT), bx(MAX_COUNT), by(MAX_COUNT), bz(MAX_COUNT);
+	for (size_t i = 0; i < MAX_COUNT; ++i)
+	{
+		ax[i] = value(generator);
+		ay[i] = value(generator);
+		az[i] = positive(generator);
+		bx[i] = value(generator);
+		by[i] = value(generator);
+		bz[i] = value(generator);
+	}
+
+	const T a = value(generator), b = value(generator), c = value(generator), d = value(generator);
+
+	const SimdKernels<T>& reference = GetSimdKernels<T>(SimdLevel::Scalar);
+	std::vector<T> expected[3] = { std::vector<T>(MAX_COUNT), std::vector<T>(MAX_COUNT), std::vector<T>(MAX_COUNT) };
+	std::vector<T> actual[3] = { std::vector<T>(MAX_COUNT), std::vector<T>(MAX_COUNT), std::vector<T>(MAX_COUNT) };
+
+	const auto compare = [&](const SimdLevel level, const char* kernel, const size_t count, const size_t outputs)
+	{
+		for (size_t output = 0; output < outputs; ++output)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (std::abs(actual[output][i] - expected[output][i]) > tolerance)
+				{
+					stream << "SIMD " << kernel << " mismatch at " << ToString(level) << ", count " << count << ", index " << i
+						<< ": " << actual[output][i] << " != " << expected[output][i] << '\n';
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	bool retval = true;
+	for (SimdLevel level = SimdLevel::Sse2; level <= GetSupportedSimdLevel(); level = static_cast<SimdLevel>(static_cast<int>(level) + 1))
+	{
+		const SimdKernels<T>& kernels = GetSimdKernels<T>(level);
+
+		for (const size_t count : COUNTS)
+		{
+			reference.DotProduct(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), expected[0].data(), count);
+			kernels.DotProduct(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), actual[0].data(), count);
+			retval &= compare(level, "DotProduct", count, 1);
+
+			reference.CrossProduct(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), expected[0].data(), expected[1].data(), expected[2].data(), count);
+			kernels.CrossProduct(ax.data(), ay.data(), az.data(), bx.data(), by.data(), bz.data(), actual[0].data(), actual[1].data(), actual[2].data(), count);
+			retval &= compare(level, "CrossProduct", count, 3);
+
+			reference.Normalize(ax.data(), ay.data(), az.data(), expected[0].data(), expected[1].data(), expected[2].data(), count);
+			kernels.Normalize(ax.data(), ay.data(), az.data(), actual[0].data(), actual[1].data(), actual[2].data(), count);
+			retval &= compare(level, "Normalize", count, 3);
+
+			reference.RelativeDistanceTo(a, b, c, d, ax.data(), ay.data(), az.data(), expected[0].data(), count);
+			kernels.RelativeDistanceTo(a, b, c, d, ax.data(), ay.data(), az.data(), actual[0].data(), count);
+			retval &= compare(level, "RelativeDistanceTo", count, 1);
+		}
+	}
+
+	return retval;
+}
+
+inline bool CheckSimdKernels(std::ostream& stream)
+{
+	const bool isFloatValid = CheckSimdKernels<float>(stream);
+	const bool isDoubleValid = CheckSimdKernels<double>(stream);
+
+	return isFloatValid && isDoubleValid;
+}
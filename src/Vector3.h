@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Assert.h"
+#include "Instrumentation.h"
 #include "Math.h"
 #include "Point3.h"
 
@@ -70,7 +72,10 @@ inline T Vector3<T>::MagnitudeSquared() const
 template <typename T>
 inline Vector3<T> Vector3<T>::Normalized() const
 {
+	Instrument(Vector3Normalized);
+
 	const T magnitude = Magnitude();
+	InstrumentIf(magnitude <= EPSILON, Vector3NormalizedDegenerate);
 	Assert(magnitude > EPSILON);
 
 	return { x / magnitude, y / magnitude, z / magnitude };
@@ -91,7 +96,10 @@ inline Vector3<T> Vector3<T>::CrossProduct(const Vector3& other) const
 template <typename T>
 inline T Vector3<T>::AngleBetween(const Vector3& other) const
 {
+	Instrument(Vector3AngleBetween);
+
 	const T magnitudesMultiplied = Magnitude() * other.Magnitude();
+	InstrumentIf(magnitudesMultiplied <= EPSILON, Vector3AngleBetweenDegenerate);
 	Assert(magnitudesMultiplied > EPSILON);
 
 	return acos(DotProduct(other) / magnitudesMultiplied);
@@ -5,6 +5,8 @@
 #include "Vector3.h"
 #include "Line3.h"
 #include "Plane3.h"
+#include "SimdSelfCheck.h"
+#include "FastMathSelfCheck.h"
 
 namespace
 {
@@ -97,6 +99,12 @@ int main()
     std::cout << "Distance (from Plane1 to Point): " << Round<2>(plane1.DistanceTo(point1)) << std::endl;
     std::cout << "Angle (between Plane1 and Line2): " << Round<2>(RadToDeg(plane1.AngleBetween(line2))) << std::endl;
     std::cout << "Angle (between Plane1 and Plane3): " << Round<2>(RadToDeg(plane1.AngleBetween(plane3))) << std::endl;
+    std::cout << std::endl;
+
+    const bool areSimdKernelsValid = CheckSimdKernels(std::cout);
+    std::cout << "SIMD kernels (up to " << ToString(GetSupportedSimdLevel()) << "): " << (areSimdKernelsValid ? "match scalar" : "MISMATCH") << std::endl;
+
+    const bool isFastMathValid = CheckFastMath(std::cout);
 
-    return EXIT_SUCCESS;
+    return areSimdKernelsValid && isFastMathValid ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file